@@ -1,10 +1,74 @@
 #pragma once
 
 #include "impl/base.h"
+#include "task_group.h"
 #include "impl/cmd_reader_windows.h"
 
+namespace xlang::impl
+{
+    // Matches a file or directory name against a pattern where '*' matches any run of characters and
+    // '?' matches a single character.
+    inline bool glob_match(std::string_view const& pattern, std::string_view const& name) noexcept
+    {
+        size_t pattern_index{};
+        size_t name_index{};
+        size_t star = std::string_view::npos;
+        size_t star_match{};
+
+        while (name_index < name.size())
+        {
+            if (pattern_index < pattern.size() && (pattern[pattern_index] == '?' || pattern[pattern_index] == name[name_index]))
+            {
+                ++pattern_index;
+                ++name_index;
+            }
+            else if (pattern_index < pattern.size() && pattern[pattern_index] == '*')
+            {
+                star = pattern_index++;
+                star_match = name_index;
+            }
+            else if (star != std::string_view::npos)
+            {
+                pattern_index = star + 1;
+                name_index = ++star_match;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (pattern_index < pattern.size() && pattern[pattern_index] == '*')
+        {
+            ++pattern_index;
+        }
+
+        return pattern_index == pattern.size();
+    }
+
+    inline bool glob_match_any(std::vector<std::string> const& patterns, std::string_view const& name) noexcept
+    {
+        return std::any_of(patterns.begin(), patterns.end(), [&](auto&& pattern)
+        {
+            return glob_match(pattern, name);
+        });
+    }
+}
+
 namespace xlang::cmd
 {
+    // Controls how folders named on the command line are scanned. A depth of zero scans only the
+    // folder itself. Files must match one of the include patterns, if any, and files or folders
+    // matching an exclude pattern are skipped.
+    struct file_search
+    {
+        static constexpr uint32_t unlimited_depth = std::numeric_limits<uint32_t>::max();
+
+        uint32_t depth{ unlimited_depth };
+        std::vector<std::string> include;
+        std::vector<std::string> exclude;
+    };
+
     struct option
     {
         static constexpr uint32_t no_min = 0;
@@ -105,24 +169,96 @@ namespace xlang::cmd
             return result->second.front();
         }
 
+        // Reads the scan-depth, scan-match and scan-skip options, for tools that offer them.
+        file_search search() const
+        {
+            file_search result;
+            auto const depth = value("scan-depth");
+
+            if (!depth.empty())
+            {
+                auto const [end, error] = std::from_chars(depth.data(), depth.data() + depth.size(), result.depth);
+
+                if (error != std::errc{} || end != depth.data() + depth.size())
+                {
+                    throw_invalid("Option '-scan-depth' requires a number");
+                }
+            }
+
+            result.include = values("scan-match");
+            result.exclude = values("scan-skip");
+            return result;
+        }
+
         template <typename F>
-        auto files(std::string_view const& name, F directory_filter) const
+        auto files(std::string_view const& name, F directory_filter, file_search const& search = {}) const
         {
             std::set<std::string> files;
+            std::vector<std::string> candidates;
+            std::vector<std::filesystem::path> roots;
 
-            auto add_directory = [&](auto&& path)
+            auto add_directory = [&](std::filesystem::path const& root)
             {
-                for (auto&& file : std::filesystem::directory_iterator(path))
+                roots.push_back(std::filesystem::canonical(root));
+            };
+
+            // Walks the folder trees breadth-first, so that each folder is first reached by its shortest
+            // route and the depth limit applies to that route. Folders are identified by their canonical
+            // path so that a link cycle, or a folder reached by more than one route, is only scanned once.
+            // Files reached through a link are canonicalized for the same reason.
+            auto scan_directories = [&]
+            {
+                std::set<std::filesystem::path> visited;
+                std::set<std::string> seen;
+                std::vector<std::filesystem::path> level = std::move(roots);
+
+                for (uint32_t depth{}; !level.empty(); ++depth)
                 {
-                    if (std::filesystem::is_regular_file(file))
+                    std::vector<std::filesystem::path> next;
+
+                    for (auto&& directory : level)
                     {
-                        auto filename = file.path().string();
+                        if (!visited.insert(directory).second)
+                        {
+                            continue;
+                        }
 
-                        if (directory_filter(filename))
+                        for (auto&& entry : std::filesystem::directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied))
                         {
-                            files.insert(filename);
+                            auto const filename = entry.path().filename().string();
+
+                            if (impl::glob_match_any(search.exclude, filename))
+                            {
+                                continue;
+                            }
+
+                            std::error_code error;
+                            auto target = entry.is_symlink(error) ? std::filesystem::canonical(entry.path(), error) : entry.path();
+
+                            if (error)
+                            {
+                                // A broken link.
+                                continue;
+                            }
+
+                            if (entry.is_directory(error))
+                            {
+                                if (depth < search.depth)
+                                {
+                                    next.push_back(std::move(target));
+                                }
+                            }
+                            else if (entry.is_regular_file(error) && (search.include.empty() || impl::glob_match_any(search.include, filename)))
+                            {
+                                if (auto file = target.string(); seen.insert(file).second)
+                                {
+                                    candidates.push_back(std::move(file));
+                                }
+                            }
                         }
                     }
+
+                    level = std::move(next);
                 }
             };
 
@@ -130,7 +266,7 @@ namespace xlang::cmd
             {
                 if (std::filesystem::is_directory(path))
                 {
-                    add_directory(std::filesystem::canonical(path));
+                    add_directory(path);
                     continue;
                 }
 
@@ -198,12 +334,42 @@ namespace xlang::cmd
                 throw_invalid("Path '", path, "' is not a file or directory");
             }
 
+            scan_directories();
+
+            // The filter usually opens each file to inspect its headers, so a few workers share the
+            // candidates between them.
+            std::vector<uint8_t> matches(candidates.size());
+            std::atomic<size_t> next{};
+            size_t const workers = (std::min)(candidates.size(), static_cast<size_t>((std::max)(1u, std::thread::hardware_concurrency())));
+            task_group group;
+
+            for (size_t worker{}; worker < workers; ++worker)
+            {
+                group.add([&]
+                {
+                    for (size_t index = next++; index < candidates.size(); index = next++)
+                    {
+                        matches[index] = directory_filter(candidates[index]);
+                    }
+                });
+            }
+
+            group.get();
+
+            for (size_t index{}; index < candidates.size(); ++index)
+            {
+                if (matches[index])
+                {
+                    files.insert(std::move(candidates[index]));
+                }
+            }
+
             return files;
         }
 
-        auto files(std::string_view const& name) const
+        auto files(std::string_view const& name, file_search const& search = {}) const
         {
-            return files(name, [](auto&&) {return true; });
+            return files(name, [](auto&&) {return true; }, search);
         }
 
     private:
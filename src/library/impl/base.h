@@ -17,18 +17,32 @@
 #include <unistd.h>
 #endif
 
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
 #include <stdexcept>
 #include <assert.h>
+#include <cerrno>
+#include <cstring>
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <charconv>
 #include <fstream>
 #include <future>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <regex>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <typeindex>
 #include <variant>
 #include <vector>
 #include <set>
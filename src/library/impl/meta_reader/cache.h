@@ -8,64 +8,44 @@ namespace xlang::meta::reader
         cache& operator=(cache const&) = delete;
 
         template<typename C, typename T = typename C::value_type>
-        explicit cache(C const& files)
+        explicit cache(C const& files) : cache{ files, {} }
         {
-            for (auto&& file : files)
-            {
-                auto& db = m_databases.emplace_back(file, this);
+        }
 
-                for (auto&& type : db.TypeDef)
-                {
-                    if (!type.Flags().WindowsRuntime())
-                    {
-                        continue;
-                    }
+        // An image in memory that the cache reads in place, such as a winmd embedded in a binary.
+        struct image
+        {
+            byte_view data;
+            lifetime_token lifetime;
+        };
 
-                    auto& ns = m_namespaces[type.TypeNamespace()];
-                    ns.types.try_emplace(type.TypeName(), type);
-                }
+        // Databases are added in order, files first, so that a type defined by a file takes
+        // precedence over one of the same name defined by an image.
+        template<typename C, typename T = typename C::value_type>
+        cache(C const& files, std::vector<image> const& images)
+        {
+            for (auto&& file : files)
+            {
+                add_types(m_databases.emplace_back(file, this));
             }
 
-            for (auto&&[namespace_name, members] : m_namespaces)
+            for (auto&& image : images)
             {
-                for (auto&&[name, type] : members.types)
-                {
-                    switch (get_category(type))
-                    {
-                    case category::interface_type:
-                        members.interfaces.push_back(type);
-                        continue;
-                    case category::class_type:
-                        if (extends_type(type, "System"sv, "Attribute"sv))
-                        {
-                            members.attributes.push_back(type);
-                            continue;
-                        }
-                        members.classes.push_back(type);
-                        continue;
-                    case category::enum_type:
-                        members.enums.push_back(type);
-                        continue;
-                    case category::struct_type:
-                        if (get_attribute(type, "Windows.Foundation.Metadata"sv, "ApiContractAttribute"sv))
-                        {
-                            members.contracts.push_back(type);
-                            continue;
-                        }
-                        members.structs.push_back(type);
-                        continue;
-                    case category::delegate_type:
-                        members.delegates.push_back(type);
-                        continue;
-                    }
-                }
+                add_types(m_databases.emplace_back(image.data, image.lifetime, this));
             }
         }
 
+        explicit cache(std::vector<image> const& images) : cache{ std::vector<std::string>{}, images }
+        {
+        }
+
         explicit cache(std::string const& file) : cache{ std::vector<std::string>{ file } }
         {
         }
 
+        // Lookups don't lock the cache. While another thread may add or remove databases, hold
+        // lock_shared() for as long as the results are used: the TypeDefs, namespace members and
+        // databases they refer to may be released by an update.
         TypeDef find(std::string_view const& type_namespace, std::string_view const& type_name) const noexcept
         {
             auto ns = m_namespaces.find(type_namespace);
@@ -131,25 +111,82 @@ namespace xlang::meta::reader
             return m_namespaces;
         }
 
+        // Keeps other threads from updating the cache until the lock is released. Any number of
+        // readers may hold it at once. It isn't recursive, so take it once around a series of lookups.
+        std::shared_lock<std::shared_mutex> lock_shared() const
+        {
+            return std::shared_lock{ m_update_lock };
+        }
+
+        // Adds a database to the cache, updating only the namespaces that it contributes types to.
+        // Types already in the cache take precedence over types of the same name in the new database.
+        // The file is read before the cache is locked for the update.
+        database const& add_database(std::string_view const& path)
+        {
+            std::list<database> loaded;
+            auto& db = loaded.emplace_back(path, this);
+
+            std::unique_lock const guard{ m_update_lock };
+            insert_databases(loaded);
+            return db;
+        }
+
+        // Removes the database loaded from the path, if any. Types it hid by defining them first are
+        // indexed from the remaining databases. Other databases, their types and the members of
+        // namespaces that still have types are left in place, so references to them remain valid.
+        // The database's own types and any namespaces it leaves empty are released.
+        bool remove_database(std::string_view const& path)
+        {
+            std::unique_lock const guard{ m_update_lock };
+            return erase_database(path);
+        }
+
+        // Replaces the database loaded from each path with the file's current contents. A path that
+        // is no longer a database is removed, and one that wasn't loaded is added. The files are read
+        // before the cache is locked and the whole batch is applied under one lock, so readers see
+        // either none of the changes or all of them.
+        void reload(std::vector<std::string> const& paths)
+        {
+            std::list<database> loaded;
+
+            for (auto&& path : paths)
+            {
+                std::error_code error;
+
+                if (std::filesystem::is_regular_file(path, error) && database::is_database(path))
+                {
+                    loaded.emplace_back(path, this);
+                }
+            }
+
+            std::unique_lock const guard{ m_update_lock };
+
+            for (auto&& path : paths)
+            {
+                erase_database(path);
+            }
+
+            insert_databases(loaded);
+        }
+
         void remove_type(std::string_view const& ns, std::string_view const& name)
         {
+            std::unique_lock const guard{ m_update_lock };
             auto m = m_namespaces.find(ns);
             if (m == m_namespaces.end())
             {
                 return;
             }
             auto& members = m->second;
+            members.categorize();
 
             auto remove = [&](auto&& collection, auto&& name)
             {
-                auto pos = std::find_if(collection.begin(), collection.end(), [&](auto&& type)
-                    {
-                        return type.TypeName() == name;
-                    });
+                auto pos = find_type(collection.m_types, name);
 
-                if (pos != collection.end())
+                if (pos != collection.m_types.end() && pos->TypeName() == name)
                 {
-                    collection.erase(pos);
+                    collection.m_types.erase(pos);
                 }
             };
 
@@ -160,23 +197,321 @@ namespace xlang::meta::reader
             remove(members.delegates, name);
         }
 
+        // The number of namespaces whose types have been sorted into categories.
+        size_t categorized_namespaces() const noexcept
+        {
+            return std::count_if(m_namespaces.begin(), m_namespaces.end(), [](auto&& ns)
+            {
+                return ns.second.categorized();
+            });
+        }
+
+        // Estimates the memory held by the cache, from the database images to the containers indexing
+        // their types. Category lists are only counted for namespaces that have been categorized.
+        reader::memory_report memory_report() const
+        {
+            memory_usage files{ "files" };
+            memory_usage databases{ "databases" };
+            memory_usage namespaces{ "namespaces" };
+            memory_usage types{ "types" };
+            memory_usage categories{ "categories" };
+
+            for (auto&& db : m_databases)
+            {
+                files += db.get_memory_usage();
+            }
+
+            databases.nodes = node_bytes(m_databases);
+            namespaces.nodes = node_bytes(m_namespaces);
+
+            for (auto&& [name, members] : m_namespaces)
+            {
+                types.nodes += node_bytes(members.types);
+
+                if (members.categorized())
+                {
+                    for (auto list : { &members.interfaces, &members.classes, &members.enums, &members.structs, &members.delegates, &members.attributes, &members.contracts })
+                    {
+                        categories.vectors += vector_bytes(list->m_types);
+                    }
+                }
+            }
+
+            return { { files, databases, namespaces, types, categories } };
+        }
+
+        // The types of a namespace are only sorted into categories, which means decoding the base type
+        // and attributes of each one, when one of the category lists is first used. Tools that only
+        // look at a few of the namespaces in a cache don't pay for the rest.
         struct namespace_members
         {
+            namespace_members() noexcept = default;
+            namespace_members(namespace_members const&) = delete;
+            namespace_members& operator=(namespace_members const&) = delete;
+
+            struct type_list
+            {
+                explicit type_list(namespace_members const* owner) noexcept : m_owner(owner)
+                {
+                }
+
+                type_list(type_list const&) = delete;
+                type_list& operator=(type_list const&) = delete;
+
+                std::vector<TypeDef> const& get() const
+                {
+                    m_owner->categorize();
+                    return m_types;
+                }
+
+                operator std::vector<TypeDef> const&() const
+                {
+                    return get();
+                }
+
+                auto begin() const
+                {
+                    return get().begin();
+                }
+
+                auto end() const
+                {
+                    return get().end();
+                }
+
+                size_t size() const
+                {
+                    return get().size();
+                }
+
+                bool empty() const
+                {
+                    return get().empty();
+                }
+
+                TypeDef const& operator[](size_t const index) const
+                {
+                    return get()[index];
+                }
+
+            private:
+
+                friend cache;
+                friend namespace_members;
+                namespace_members const* const m_owner;
+                mutable std::vector<TypeDef> m_types;
+            };
+
             std::map<std::string_view, TypeDef> types;
-            std::vector<TypeDef> interfaces;
-            std::vector<TypeDef> classes;
-            std::vector<TypeDef> enums;
-            std::vector<TypeDef> structs;
-            std::vector<TypeDef> delegates;
-            std::vector<TypeDef> attributes;
-            std::vector<TypeDef> contracts;
+            type_list interfaces{ this };
+            type_list classes{ this };
+            type_list enums{ this };
+            type_list structs{ this };
+            type_list delegates{ this };
+            type_list attributes{ this };
+            type_list contracts{ this };
+
+            // Sorts the types into categories once, even if called from several threads. Readers that
+            // may race an update hold the cache's lock_shared() while they use the lists.
+            void categorize() const
+            {
+                std::call_once(m_categorize, [&]
+                {
+                    for (auto&& [name, type] : types)
+                    {
+                        category_list(type).m_types.push_back(type);
+                    }
+
+                    m_categorized.store(true, std::memory_order_release);
+                });
+            }
+
+            bool categorized() const noexcept
+            {
+                return m_categorized.load(std::memory_order_acquire);
+            }
+
+        private:
+
+            friend cache;
+
+            type_list const& category_list(TypeDef const& type) const
+            {
+                switch (get_category(type))
+                {
+                case category::interface_type:
+                    return interfaces;
+                case category::class_type:
+                    if (extends_type(type, "System"sv, "Attribute"sv))
+                    {
+                        return attributes;
+                    }
+                    return classes;
+                case category::enum_type:
+                    return enums;
+                case category::struct_type:
+                    if (get_attribute(type, "Windows.Foundation.Metadata"sv, "ApiContractAttribute"sv))
+                    {
+                        return contracts;
+                    }
+                    return structs;
+                default:
+                    return delegates;
+                }
+            }
+
+            mutable std::once_flag m_categorize;
+            mutable std::atomic<bool> m_categorized{};
         };
 
         using namespace_type = std::pair<std::string_view const, namespace_members> const&;
 
     private:
 
+        // Moves the loaded databases to the end of the cache and indexes their types. Called with the
+        // update lock held.
+        void insert_databases(std::list<database>& loaded)
+        {
+            if (loaded.empty())
+            {
+                return;
+            }
+
+            auto const first = loaded.begin();
+            m_databases.splice(m_databases.end(), loaded);
+
+            for (auto db = first; db != m_databases.end(); ++db)
+            {
+                add_types(*db);
+            }
+        }
+
+        // Called with the update lock held.
+        bool erase_database(std::string_view const& path)
+        {
+            auto db = std::find_if(m_databases.begin(), m_databases.end(), [&](auto&& db)
+            {
+                return db.path() == path;
+            });
+
+            if (db == m_databases.end())
+            {
+                return false;
+            }
+
+            std::set<std::string> affected;
+            std::set<std::pair<std::string_view, std::string_view>> removed;
+
+            for (auto&& type : db->TypeDef)
+            {
+                auto ns = m_namespaces.find(type.TypeNamespace());
+
+                if (ns == m_namespaces.end())
+                {
+                    continue;
+                }
+
+                auto existing = ns->second.types.find(type.TypeName());
+
+                if (existing == ns->second.types.end() || existing->second != type)
+                {
+                    continue;
+                }
+
+                if (ns->second.categorized())
+                {
+                    erase_type(ns->second.category_list(type).m_types, type);
+                }
+
+                ns->second.types.erase(existing);
+                affected.emplace(type.TypeNamespace());
+                removed.emplace(type.TypeNamespace(), type.TypeName());
+            }
+
+            for (auto&& other : m_databases)
+            {
+                if (&other == &*db || removed.empty())
+                {
+                    continue;
+                }
+
+                for (auto&& type : other.TypeDef)
+                {
+                    if (!type.Flags().WindowsRuntime() || !removed.count({ type.TypeNamespace(), type.TypeName() }))
+                    {
+                        continue;
+                    }
+
+                    add_type(m_namespaces[type.TypeNamespace()], type);
+                }
+            }
+
+            // Namespace names refer to the strings of the database that first defined them, so the
+            // remaining namespaces are keyed again by one of their own types before it is unloaded.
+            for (auto&& name : affected)
+            {
+                auto node = m_namespaces.extract(name);
+
+                if (!node.mapped().types.empty())
+                {
+                    node.key() = node.mapped().types.begin()->second.TypeNamespace();
+                    m_namespaces.insert(std::move(node));
+                }
+            }
+
+            m_databases.erase(db);
+            return true;
+        }
+
+        void add_types(database const& db)
+        {
+            for (auto&& type : db.TypeDef)
+            {
+                if (!type.Flags().WindowsRuntime())
+                {
+                    continue;
+                }
+
+                add_type(m_namespaces[type.TypeNamespace()], type);
+            }
+        }
+
+        // Adds a type unless one of the same name is already indexed. A namespace that has already
+        // been categorized is kept up to date.
+        static void add_type(namespace_members& members, TypeDef const& type)
+        {
+            if (members.types.try_emplace(type.TypeName(), type).second && members.categorized())
+            {
+                insert_type(members.category_list(type).m_types, type);
+            }
+        }
+
+        // The categorized lists are ordered by name, as namespace_members::types is.
+        static std::vector<TypeDef>::iterator find_type(std::vector<TypeDef>& list, std::string_view const& name)
+        {
+            return std::lower_bound(list.begin(), list.end(), name, [](TypeDef const& type, std::string_view const& name)
+            {
+                return type.TypeName() < name;
+            });
+        }
+
+        static void insert_type(std::vector<TypeDef>& list, TypeDef const& type)
+        {
+            list.insert(find_type(list, type.TypeName()), type);
+        }
+
+        static void erase_type(std::vector<TypeDef>& list, TypeDef const& type)
+        {
+            auto position = std::find(find_type(list, type.TypeName()), list.end(), type);
+
+            if (position != list.end())
+            {
+                list.erase(position);
+            }
+        }
+
         std::list<database> m_databases;
         std::map<std::string_view, namespace_members> m_namespaces;
+        mutable std::shared_mutex m_update_lock;
     };
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+namespace xlang::meta::reader
+{
+#if defined(__linux__)
+
+    // Keeps a cache in step with the files it was loaded from. Changes are collected with inotify
+    // but only applied by refresh, as one cache::reload, so readers holding the cache's lock_shared()
+    // on other threads never see a partial update.
+    // The folders holding the files are watched rather than the files themselves, so that a file
+    // replaced by renaming another over it is still noticed.
+    struct cache_watcher
+    {
+        cache_watcher(cache_watcher const&) = delete;
+        cache_watcher& operator=(cache_watcher const&) = delete;
+
+        explicit cache_watcher(cache& c) : m_cache(c), m_handle(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+        {
+            if (m_handle == -1)
+            {
+                throw_invalid("Could not create inotify instance");
+            }
+
+            for (auto&& db : c.databases())
+            {
+                if (!db.path().empty())
+                {
+                    watch(db.path());
+                }
+            }
+        }
+
+        ~cache_watcher() noexcept
+        {
+            ::close(m_handle);
+        }
+
+        // Watches a file whether or not it is currently in the cache, so that it is added once it
+        // is created.
+        void watch(std::string_view const& path)
+        {
+            std::filesystem::path const file{ path };
+            auto folder = file.parent_path();
+
+            if (folder.empty())
+            {
+                folder = ".";
+            }
+
+            int const watch = inotify_add_watch(m_handle, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE);
+
+            if (watch == -1)
+            {
+                throw_invalid("Could not watch folder '", folder.string(), "'");
+            }
+
+            m_watches[watch].insert_or_assign(file.filename().string(), std::string{ path });
+        }
+
+        // Waits up to timeout milliseconds for changes, then reloads every watched file that
+        // changed and returns their paths. A file that was deleted or is no longer a valid
+        // database is removed from the cache.
+        std::vector<std::string> refresh(int const timeout = 0)
+        {
+            std::set<std::string> changed;
+            pollfd descriptor{ m_handle, POLLIN, 0 };
+
+            if (::poll(&descriptor, 1, timeout) <= 0)
+            {
+                return {};
+            }
+
+            alignas(inotify_event) char buffer[4096];
+
+            while (true)
+            {
+                ssize_t const size = ::read(m_handle, buffer, sizeof(buffer));
+
+                if (size <= 0)
+                {
+                    if (size == -1 && errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                for (char const* position = buffer; position < buffer + size;)
+                {
+                    auto const& event = *reinterpret_cast<inotify_event const*>(position);
+                    position += sizeof(inotify_event) + event.len;
+
+                    if (event.len == 0)
+                    {
+                        continue;
+                    }
+
+                    auto files = m_watches.find(event.wd);
+
+                    if (files == m_watches.end())
+                    {
+                        continue;
+                    }
+
+                    auto file = files->second.find(event.name);
+
+                    if (file != files->second.end())
+                    {
+                        changed.insert(file->second);
+                    }
+                }
+            }
+
+            std::vector<std::string> result{ changed.begin(), changed.end() };
+            m_cache.reload(result);
+            return result;
+        }
+
+    private:
+
+        cache& m_cache;
+        int const m_handle;
+        std::map<int, std::map<std::string, std::string, std::less<>>> m_watches;
+    };
+
+#endif
+}
@@ -25,88 +25,25 @@ namespace xlang::meta::reader
 {
     struct cache;
 
+    // Keeps a caller's buffer alive for as long as a database reads from it in place.
+    using lifetime_token = std::shared_ptr<void const>;
+
     struct database
     {
         database(database&&) = delete;
         database& operator=(database&&) = delete;
 
+        // Reads only the headers needed to find the CLI metadata rather than mapping the whole file, so
+        // that probing a directory of large binaries stays cheap.
         static bool is_database(std::string_view const& path)
         {
-            file_view file{ path };
-
-            if (file.size() < sizeof(impl::image_dos_header))
-            {
-                return false;
-            }
-
-            auto dos = file.as<impl::image_dos_header>();
-
-            if (dos.e_signature != 0x5A4D) // IMAGE_DOS_SIGNATURE
-            {
-                return false;
-            }
-
-            if (file.size() < (dos.e_lfanew + sizeof(impl::image_nt_headers32)))
-            {
-                return false;
-            }
-
-            auto pe = file.as<impl::image_nt_headers32>(dos.e_lfanew);
+            file_reader const file{ path };
+            uint32_t offset{};
 
-            if (pe.FileHeader.NumberOfSections == 0 || pe.FileHeader.NumberOfSections > 100)
-            {
-                return false;
-            }
-            
-            impl::image_section_header const* sections{};
-            uint32_t com_virtual_address{};
-            if (pe.OptionalHeader.Magic == 0x10B) // PE32
-            {
-                com_virtual_address = pe.OptionalHeader.DataDirectory[14].VirtualAddress; // IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR
-                sections = &file.as<impl::image_section_header>(dos.e_lfanew + sizeof(impl::image_nt_headers32));
-            }
-            else if (pe.OptionalHeader.Magic == 0x20B) // PE32+
+            return !find_metadata([&](uint32_t const position, void* const buffer, uint32_t const size)
             {
-                auto pe_plus = file.as<impl::image_nt_headers32plus>(dos.e_lfanew);
-                com_virtual_address = pe_plus.OptionalHeader.DataDirectory[14].VirtualAddress; // IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR
-                sections = &file.as<impl::image_section_header>(dos.e_lfanew + sizeof(impl::image_nt_headers32plus));
-            }
-            else
-            {
-                throw_invalid("Invalid optional header magic value");
-            }
-            auto sections_end = sections + pe.FileHeader.NumberOfSections;
-            auto section = section_from_rva(sections, sections_end, com_virtual_address);
-
-            if (section == sections_end)
-            {
-                return false;
-            }
-
-            auto offset = offset_from_rva(*section, com_virtual_address);
-
-            auto cli = file.as<impl::image_cor20_header>(offset);
-
-            if (cli.cb != sizeof(impl::image_cor20_header))
-            {
-                return false;
-            }
-
-            section = section_from_rva(sections, sections_end, cli.MetaData.VirtualAddress);
-
-            if (section == sections_end)
-            {
-                return false;
-            }
-
-            offset = offset_from_rva(*section, cli.MetaData.VirtualAddress);
-
-            if (file.as<uint32_t>(offset) != 0x424a5342)
-            {
-                return false;
-            }
-
-            return true;
+                return file.read(position, buffer, size);
+            }, offset);
         }
 
         explicit database(std::vector<uint8_t>&& buffer, cache const* cache = nullptr) : m_buffer{ std::move(buffer) }, m_view{ m_buffer.data(), m_buffer.data() + m_buffer.size() }, m_cache{ cache }
@@ -119,6 +56,13 @@ namespace xlang::meta::reader
             initialize();
         }
 
+        // Reads an image that the caller owns without copying it. The image must stay valid and
+        // unchanged until the lifetime token is released, which happens when the database is destroyed.
+        database(byte_view const& image, lifetime_token lifetime, cache const* cache = nullptr) : m_lifetime{ std::move(lifetime) }, m_view{ image.begin(), image.end() }, m_cache{ cache }
+        {
+            initialize();
+        }
+
         table<TypeRef> TypeRef{ this };
         table<GenericParamConstraint> GenericParamConstraint{ this };
         table<TypeSpec> TypeSpec{ this };
@@ -171,12 +115,30 @@ namespace xlang::meta::reader
             return m_path;
         }
 
+        // The memory held by the image, whether it is mapped from the file or a buffer the database owns.
+        // Images read in place belong to the caller and aren't counted.
+        memory_usage get_memory_usage() const
+        {
+            memory_usage result{ m_path };
+
+            if (m_view.backed_by_file())
+            {
+                result.mapped = m_view.size();
+                result.touched = impl::resident_bytes(m_view.begin(), m_view.size());
+            }
+
+            result.vectors = vector_bytes(m_buffer) + vector_bytes(m_padded_blobs);
+            return result;
+        }
+
         std::string_view get_string(uint32_t const index) const
         {
             auto view = m_strings.seek(index);
-            auto last = std::find(view.begin(), view.end(), 0);
 
-            if (last == view.end())
+            // memchr is vectorized by the C runtime, unlike a byte by byte search.
+            auto last = static_cast<uint8_t const*>(std::memchr(view.begin(), 0, view.size()));
+
+            if (!last)
             {
                 throw_invalid("Missing string terminator");
             }
@@ -187,107 +149,38 @@ namespace xlang::meta::reader
         byte_view get_blob(uint32_t const index) const
         {
             auto view = m_blobs.seek(index);
-            auto initial_byte = view.as<uint8_t>();
-            uint32_t blob_size_bytes{};
+            uint32_t const length = impl::compressed_length(view.as<uint8_t>());
 
-            switch (initial_byte >> 5)
+            if (length == 0)
             {
-            case 0:
-            case 1:
-            case 2:
-            case 3:
-                blob_size_bytes = 1;
-                initial_byte &= 0x7f;
-                break;
-
-            case 4:
-            case 5:
-                blob_size_bytes = 2;
-                initial_byte &= 0x3f;
-                break;
-
-            case 6:
-                blob_size_bytes = 4;
-                initial_byte &= 0x1f;
-                break;
-
-            default:
                 throw_invalid("Invalid blob encoding");
             }
 
-            uint32_t blob_size{ initial_byte };
-
-            for (auto&& byte : view.sub(1, blob_size_bytes - 1))
+            if (view.size() < length)
             {
-                blob_size = (blob_size << 8) + byte;
+                throw_invalid("Buffer too small");
             }
 
-            return { view.sub(blob_size_bytes, blob_size) };
+            return view.sub(length, impl::uncompress(view.begin(), length, view.size()));
         }
 
     private:
         void initialize()
         {
-            auto dos = m_view.as<impl::image_dos_header>();
-
-            if (dos.e_signature != 0x5A4D) // IMAGE_DOS_SIGNATURE
-            {
-                throw_invalid("Invalid DOS signature");
-            }
-
-            auto pe = m_view.as<impl::image_nt_headers32>(dos.e_lfanew);
-
-            if (pe.FileHeader.NumberOfSections == 0 || pe.FileHeader.NumberOfSections > 100)
-            {
-                throw_invalid("Invalid PE section count");
-            }
-
-            impl::image_section_header const* sections{};
-            uint32_t com_virtual_address{};
-            if (pe.OptionalHeader.Magic == 0x10B) // PE32
-            {
-                com_virtual_address = pe.OptionalHeader.DataDirectory[14].VirtualAddress; // IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR
-                sections = &m_view.as<impl::image_section_header>(dos.e_lfanew + sizeof(impl::image_nt_headers32));
-            }
-            else if (pe.OptionalHeader.Magic == 0x20B) // PE32+
-            {
-                auto pe_plus = m_view.as<impl::image_nt_headers32plus>(dos.e_lfanew);
-                com_virtual_address = pe_plus.OptionalHeader.DataDirectory[14].VirtualAddress; // IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR
-                sections = &m_view.as<impl::image_section_header>(dos.e_lfanew + sizeof(impl::image_nt_headers32plus));
-            }
-            else
-            {
-                throw_invalid("Invalid optional header magic value");
-            }
-            auto sections_end = sections + pe.FileHeader.NumberOfSections;
-            auto section = section_from_rva(sections, sections_end, com_virtual_address);
-
-            if (section == sections_end)
-            {
-                throw_invalid("PE section containing CLI header not found");
-            }
-
-            auto offset = offset_from_rva(*section, com_virtual_address);
+            uint32_t offset{};
 
-            auto cli = m_view.as<impl::image_cor20_header>(offset);
-
-            if (cli.cb != sizeof(impl::image_cor20_header))
+            if (auto const error = find_metadata([&](uint32_t const position, void* const buffer, uint32_t const size)
             {
-                throw_invalid("Invalid CLI header");
-            }
-
-            section = section_from_rva(sections, sections_end, cli.MetaData.VirtualAddress);
-
-            if (section == sections_end)
-            {
-                throw_invalid("PE section containing CLI metadata not found");
-            }
-
-            offset = offset_from_rva(*section, cli.MetaData.VirtualAddress);
+                if (position > m_view.size() || size > m_view.size() - position)
+                {
+                    return false;
+                }
 
-            if (m_view.as<uint32_t>(offset) != 0x424a5342)
+                std::memcpy(buffer, m_view.begin() + position, size);
+                return true;
+            }, offset))
             {
-                throw_invalid("CLI metadata magic signature not found");
+                throw_invalid(error);
             }
 
             auto version_length = m_view.as<uint32_t>(offset + 12);
@@ -324,6 +217,17 @@ namespace xlang::meta::reader
                 view = view.seek(stream_offset(name.data()));
             }
 
+            // Signatures are parsed without checking each read against the end of the blob, which
+            // relies on readable bytes following the heap. Images that end too soon after it get a
+            // padded copy of the heap.
+            if (m_blobs && static_cast<uint32_t>(m_view.end() - m_blobs.end()) < blob_cursor::padding)
+            {
+                m_padded_blobs.reserve(m_blobs.size() + blob_cursor::padding);
+                m_padded_blobs.assign(m_blobs.begin(), m_blobs.end());
+                m_padded_blobs.resize(m_blobs.size() + blob_cursor::padding);
+                m_blobs = { m_padded_blobs.data(), m_padded_blobs.data() + m_blobs.size() };
+            }
+
             std::bitset<8> const heap_sizes{ tables.as<uint8_t>(6) };
             uint8_t const string_index_size = heap_sizes.test(0) ? 4 : 2;
             uint8_t const guid_index_size = heap_sizes.test(1) ? 4 : 2;
@@ -510,6 +414,111 @@ namespace xlang::meta::reader
             return static_cast<uint32_t>(8 + name.size() + padding);
         }
 
+        // Follows the DOS, PE and CLI headers to the metadata root, setting offset to its position in
+        // the file. The read function copies size bytes at a file position into a buffer and returns
+        // false if the file is too small. Returns nullptr on success or a description of the problem.
+        template <typename Read>
+        static char const* find_metadata(Read const& read, uint32_t& offset)
+        {
+            impl::image_dos_header dos;
+
+            if (!read(0, &dos, sizeof(dos)))
+            {
+                return "Buffer too small";
+            }
+
+            if (dos.e_signature != 0x5A4D) // IMAGE_DOS_SIGNATURE
+            {
+                return "Invalid DOS signature";
+            }
+
+            impl::image_nt_headers32 pe;
+
+            if (!read(dos.e_lfanew, &pe, sizeof(pe)))
+            {
+                return "Buffer too small";
+            }
+
+            if (pe.FileHeader.NumberOfSections == 0 || pe.FileHeader.NumberOfSections > 100)
+            {
+                return "Invalid PE section count";
+            }
+
+            uint32_t com_virtual_address{};
+            uint32_t sections_offset{};
+
+            if (pe.OptionalHeader.Magic == 0x10B) // PE32
+            {
+                com_virtual_address = pe.OptionalHeader.DataDirectory[14].VirtualAddress; // IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR
+                sections_offset = dos.e_lfanew + sizeof(impl::image_nt_headers32);
+            }
+            else if (pe.OptionalHeader.Magic == 0x20B) // PE32+
+            {
+                impl::image_nt_headers32plus pe_plus;
+
+                if (!read(dos.e_lfanew, &pe_plus, sizeof(pe_plus)))
+                {
+                    return "Buffer too small";
+                }
+
+                com_virtual_address = pe_plus.OptionalHeader.DataDirectory[14].VirtualAddress; // IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR
+                sections_offset = dos.e_lfanew + sizeof(impl::image_nt_headers32plus);
+            }
+            else
+            {
+                return "Invalid optional header magic value";
+            }
+
+            std::array<impl::image_section_header, 100> sections;
+            auto const sections_end = sections.data() + pe.FileHeader.NumberOfSections;
+
+            if (!read(sections_offset, sections.data(), pe.FileHeader.NumberOfSections * sizeof(impl::image_section_header)))
+            {
+                return "Buffer too small";
+            }
+
+            auto section = section_from_rva(sections.data(), sections_end, com_virtual_address);
+
+            if (section == sections_end)
+            {
+                return "PE section containing CLI header not found";
+            }
+
+            impl::image_cor20_header cli;
+
+            if (!read(offset_from_rva(*section, com_virtual_address), &cli, sizeof(cli)))
+            {
+                return "Buffer too small";
+            }
+
+            if (cli.cb != sizeof(impl::image_cor20_header))
+            {
+                return "Invalid CLI header";
+            }
+
+            section = section_from_rva(sections.data(), sections_end, cli.MetaData.VirtualAddress);
+
+            if (section == sections_end)
+            {
+                return "PE section containing CLI metadata not found";
+            }
+
+            offset = offset_from_rva(*section, cli.MetaData.VirtualAddress);
+            uint32_t signature{};
+
+            if (!read(offset, &signature, sizeof(signature)))
+            {
+                return "Buffer too small";
+            }
+
+            if (signature != 0x424a5342)
+            {
+                return "CLI metadata magic signature not found";
+            }
+
+            return nullptr;
+        }
+
         static impl::image_section_header const* section_from_rva(impl::image_section_header const* const first, impl::image_section_header const* const last, uint32_t const rva) noexcept
         {
             return std::find_if(first, last, [rva](auto&& section) noexcept
@@ -523,12 +532,14 @@ namespace xlang::meta::reader
             return rva - section.VirtualAddress + section.PointerToRawData;
         }
 
+        lifetime_token m_lifetime;
         std::vector<uint8_t> m_buffer;
         file_view m_view;
 
         std::string const m_path;
         byte_view m_strings;
         byte_view m_blobs;
+        std::vector<uint8_t> m_padded_blobs;
         byte_view m_guids;
         cache const* m_cache;
     };
@@ -0,0 +1,128 @@
+namespace xlang::impl
+{
+    // The number of bytes in the range that are resident in memory, counted in whole pages. Residency
+    // is only queried on POSIX systems and is reported as zero elsewhere.
+    inline uint64_t resident_bytes([[maybe_unused]] void const* const address, [[maybe_unused]] size_t const size) noexcept
+    {
+#if XLANG_PLATFORM_WINDOWS
+        return 0;
+#else
+        if (!address || !size)
+        {
+            return 0;
+        }
+
+        uintptr_t const page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        uintptr_t const first = reinterpret_cast<uintptr_t>(address) & ~(page_size - 1);
+        uintptr_t const last = reinterpret_cast<uintptr_t>(address) + size;
+        size_t const pages = static_cast<size_t>((last - first + page_size - 1) / page_size);
+
+#if defined(__APPLE__)
+        std::vector<char> residency(pages);
+#else
+        std::vector<unsigned char> residency(pages);
+#endif
+
+        if (mincore(reinterpret_cast<void*>(first), last - first, residency.data()) != 0)
+        {
+            return 0;
+        }
+
+        return std::count_if(residency.begin(), residency.end(), [](auto page) { return page & 1; }) * static_cast<uint64_t>(page_size);
+#endif
+    }
+}
+
+namespace xlang::meta::reader
+{
+    // The approximate memory held by one structure, in bytes.
+    struct memory_usage
+    {
+        std::string name;
+        uint64_t mapped{}; // Views of files mapped into the address space
+        uint64_t touched{}; // Mapped bytes currently resident, in whole pages
+        uint64_t nodes{}; // Elements and links of node-based containers such as map, set and list
+        uint64_t vectors{}; // Capacity of vectors and owned buffers
+
+        memory_usage& operator+=(memory_usage const& other) noexcept
+        {
+            mapped += other.mapped;
+            touched += other.touched;
+            nodes += other.nodes;
+            vectors += other.vectors;
+            return *this;
+        }
+    };
+
+    // Estimates of the bytes held by standard containers. A tree node is taken to link three nodes and
+    // a color and a list node two nodes, as in the common standard library implementations. Allocator overhead is not included.
+    template <typename T>
+    uint64_t vector_bytes(std::vector<T> const& vector) noexcept
+    {
+        return vector.capacity() * sizeof(T);
+    }
+
+    template <typename K, typename V, typename C, typename A>
+    uint64_t node_bytes(std::map<K, V, C, A> const& map) noexcept
+    {
+        return map.size() * (sizeof(typename std::map<K, V, C, A>::value_type) + 4 * sizeof(void*));
+    }
+
+    template <typename K, typename C, typename A>
+    uint64_t node_bytes(std::set<K, C, A> const& set) noexcept
+    {
+        return set.size() * (sizeof(K) + 4 * sizeof(void*));
+    }
+
+    template <typename T, typename A>
+    uint64_t node_bytes(std::list<T, A> const& list) noexcept
+    {
+        return list.size() * (sizeof(T) + 2 * sizeof(void*));
+    }
+
+    struct memory_report
+    {
+        std::vector<memory_usage> structures;
+
+        memory_usage total() const noexcept
+        {
+            memory_usage result{ "total" };
+
+            for (auto&& usage : structures)
+            {
+                result += usage;
+            }
+
+            return result;
+        }
+
+        // Writes a table of the structures and their total, in kilobytes rounded up.
+        template <typename Writer>
+        void write(Writer& w) const
+        {
+            auto kilobytes = [](uint64_t const bytes)
+            {
+                return static_cast<unsigned long long>((bytes + 1023) / 1024);
+            };
+
+            auto write_row = [&](memory_usage const& usage)
+            {
+                w.write_printf(" %-16s%12llu%12llu%12llu%12llu\n",
+                    usage.name.c_str(),
+                    kilobytes(usage.mapped),
+                    kilobytes(usage.touched),
+                    kilobytes(usage.nodes),
+                    kilobytes(usage.vectors));
+            };
+
+            w.write_printf(" %-16s%12s%12s%12s%12s\n", "memory (KB)", "mapped", "touched", "nodes", "vectors");
+
+            for (auto&& usage : structures)
+            {
+                write_row(usage);
+            }
+
+            write_row(total());
+        }
+    };
+}
@@ -106,7 +106,7 @@ namespace xlang::meta::reader
 
         MethodDefSig Signature() const
         {
-            auto cursor = get_blob(4);
+            blob_cursor cursor{ get_blob(4) };
             return{ get_table(), cursor };
         }
 
@@ -137,7 +137,7 @@ namespace xlang::meta::reader
 
         MethodDefSig MethodSignature() const
         {
-            auto cursor = get_blob(2);
+            blob_cursor cursor{ get_blob(2) };
             return{ get_table(), cursor };
         }
 
@@ -172,7 +172,7 @@ namespace xlang::meta::reader
 
         auto Signature() const
         {
-            auto cursor = get_blob(2);
+            blob_cursor cursor{ get_blob(2) };
             return FieldSig{ get_table(), cursor };
         }
 
@@ -263,7 +263,7 @@ namespace xlang::meta::reader
 
         TypeSpecSig Signature() const
         {
-            auto cursor = get_blob(0);
+            blob_cursor cursor{ get_blob(0) };
             return{ get_table(), cursor };
         }
 
@@ -360,7 +360,7 @@ namespace xlang::meta::reader
 
         PropertySig Type() const
         {
-            auto cursor = get_blob(2);
+            blob_cursor cursor{ get_blob(2) };
             return{ get_table(), cursor };
         }
 
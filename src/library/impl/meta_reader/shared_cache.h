@@ -0,0 +1,116 @@
+namespace xlang::meta::reader
+{
+    // A cache shared by everything in the process that reads the same set of files, such as several
+    // code generators driven from one build process. The cache is loaded once and is only handed
+    // out as const, so it can be read from any thread. It is unloaded when the last user releases it.
+    struct shared_cache
+    {
+        shared_cache(shared_cache const&) = delete;
+        shared_cache& operator=(shared_cache const&) = delete;
+
+        // Returns the cache for the files, loading it unless another user already holds it. The
+        // paths are canonicalized and sorted, so neither their order nor spelling matters.
+        static std::shared_ptr<shared_cache const> get(std::vector<std::string> const& files)
+        {
+            std::vector<std::string> key;
+
+            for (auto&& file : files)
+            {
+                key.push_back(std::filesystem::canonical(file).string());
+            }
+
+            std::sort(key.begin(), key.end());
+            key.erase(std::unique(key.begin(), key.end()), key.end());
+
+            std::shared_ptr<shared_cache> result;
+            auto& registry = get_registry();
+
+            {
+                std::lock_guard const guard{ registry.lock };
+
+                for (auto entry = registry.entries.begin(); entry != registry.entries.end();)
+                {
+                    entry = entry->second.expired() ? registry.entries.erase(entry) : std::next(entry);
+                }
+
+                auto& entry = registry.entries[key];
+                result = entry.lock();
+
+                if (!result)
+                {
+                    result.reset(new shared_cache{ std::move(key) });
+                    entry = result;
+                }
+            }
+
+            // Loading happens outside of the registry lock so that different sets of files load in
+            // parallel. If loading fails, the next caller tries again.
+            std::call_once(result->m_load, [&]
+            {
+                result->m_cache.emplace(result->m_files);
+            });
+
+            return result;
+        }
+
+        cache const& get() const noexcept
+        {
+            return *m_cache;
+        }
+
+        std::vector<std::string> const& files() const noexcept
+        {
+            return m_files;
+        }
+
+        // Returns data of type T derived from the cache, constructing it from the cache the first time
+        // it is asked for. Like the cache, an extension is shared read-only and lives as long as it.
+        template <typename T>
+        T const& extension() const
+        {
+            extension_slot* slot{};
+
+            {
+                std::lock_guard const guard{ m_extensions_lock };
+                slot = &m_extensions[typeid(T)];
+            }
+
+            std::call_once(slot->once, [&]
+            {
+                slot->value = std::make_shared<T const>(get());
+            });
+
+            return *static_cast<T const*>(slot->value.get());
+        }
+
+    private:
+
+        struct registry_type
+        {
+            std::mutex lock;
+            std::map<std::vector<std::string>, std::weak_ptr<shared_cache>> entries;
+        };
+
+        struct extension_slot
+        {
+            std::once_flag once;
+            std::shared_ptr<void const> value;
+        };
+
+        explicit shared_cache(std::vector<std::string>&& files) noexcept : m_files(std::move(files))
+        {
+        }
+
+        static registry_type& get_registry() noexcept
+        {
+            static registry_type registry;
+            return registry;
+        }
+
+        std::vector<std::string> const m_files;
+        std::once_flag m_load;
+        std::optional<cache> m_cache;
+        mutable std::mutex m_extensions_lock;
+        mutable std::map<std::type_index, extension_slot> m_extensions;
+    };
+}
@@ -3,34 +3,21 @@ namespace xlang::meta::reader
 {
     inline uint32_t uncompress_unsigned(byte_view& cursor)
     {
-        auto data = cursor.begin();
-        uint32_t value;
-        uint32_t length;
-        if ((*data & 0x80) == 0x00)
-        {
-            length = 1;
-            value = *data;
-        }
-        else if ((*data & 0xc0) == 0x80)
-        {
-            length = 2;
-            value = (*data++ & 0x3f) << 8;
-            value |= *data;
-        }
-        else if ((*data & 0xe0) == 0xc0)
+        auto const first = cursor.begin();
+        uint32_t const length = impl::compressed_length(cursor.as<uint8_t>());
+
+        if (length == 0)
         {
-            length = 4;
-            value = (*data++ & 0x1f) << 24;
-            value |= *data++ << 16;
-            value |= *data++ << 8;
-            value |= *data;
+            throw_invalid("Invalid compressed integer in blob");
         }
-        else
+
+        if (cursor.size() < length)
         {
-            throw_invalid("Invalid compressed integer in blob");
+            throw_invalid("Buffer too small");
         }
-        cursor = cursor.seek(length);
-        return value;
+
+        cursor = { first + length, cursor.end() };
+        return impl::uncompress(first, length, static_cast<uint32_t>(cursor.end() - first));
     }
 
     template <typename T>
@@ -58,6 +45,105 @@ namespace xlang::meta::reader
         return result;
     }
 
+    // Parses a blob whose extent get_blob checked once, when it was read from the heap. Reads don't
+    // compare the position with the end of the blob. Instead the heap is always followed by at least
+    // padding readable bytes, and parsers call check() once per element, before the few reads that
+    // make up an element could run past that padding. A blob that ends early is therefore still
+    // reported as invalid, just at the end of the element rather than at the read that overran it.
+    struct blob_cursor
+    {
+        static constexpr uint32_t padding{ 32 };
+
+        explicit blob_cursor(byte_view const& blob) noexcept : m_first(blob.begin()), m_last(blob.end())
+        {
+        }
+
+        bool empty() const noexcept
+        {
+            return m_first >= m_last;
+        }
+
+        uint32_t size() const noexcept
+        {
+            return empty() ? 0 : static_cast<uint32_t>(m_last - m_first);
+        }
+
+        uint8_t const* begin() const noexcept
+        {
+            return m_first;
+        }
+
+        uint8_t const* end() const noexcept
+        {
+            return m_last;
+        }
+
+        void check() const
+        {
+            if (m_first > m_last)
+            {
+                throw_invalid("Buffer too small");
+            }
+        }
+
+        uint8_t peek() const noexcept
+        {
+            return *m_first;
+        }
+
+        uint8_t read_byte() noexcept
+        {
+            return *m_first++;
+        }
+
+        // The number of bytes taken by the compressed integer at the current position.
+        uint32_t compressed_size() const
+        {
+            uint32_t const length = impl::compressed_length(peek());
+
+            if (length == 0)
+            {
+                throw_invalid("Invalid compressed integer in blob");
+            }
+
+            return length;
+        }
+
+        uint32_t read_compressed()
+        {
+            uint32_t const length = compressed_size();
+            uint32_t const value = impl::uncompress(m_first, length, 4);
+            m_first += length;
+            return value;
+        }
+
+        template <typename T>
+        T read_enum()
+        {
+            static_assert(std::is_enum_v<T>);
+            static_assert(std::is_unsigned_v<std::underlying_type_t<T>>);
+            return static_cast<T>(read_compressed());
+        }
+
+        // Unlike the other reads, the count may be anything, so it is checked against the blob.
+        byte_view read_bytes(uint32_t const count)
+        {
+            if (size() < count)
+            {
+                throw_invalid("Buffer too small");
+            }
+
+            byte_view const result{ m_first, m_first + count };
+            m_first += count;
+            return result;
+        }
+
+    private:
+
+        uint8_t const* m_first;
+        uint8_t const* m_last;
+    };
+
     struct CustomModSig;
     struct FieldSig;
     struct GenericTypeInstSig;
@@ -70,9 +156,9 @@ namespace xlang::meta::reader
 
     struct CustomModSig
     {
-        CustomModSig(table_base const* table, byte_view& data)
-            : m_cmod(uncompress_enum<ElementType>(data))
-            , m_type(table, uncompress_unsigned(data))
+        CustomModSig(table_base const* table, blob_cursor& data)
+            : m_cmod(data.read_enum<ElementType>())
+            , m_type(table, data.read_compressed())
         {
             XLANG_ASSERT(m_cmod == ElementType::CModReqd || m_cmod == ElementType::CModOpt);
         }
@@ -94,7 +180,7 @@ namespace xlang::meta::reader
 
     struct GenericTypeInstSig
     {
-        GenericTypeInstSig(table_base const* table, byte_view& data);
+        GenericTypeInstSig(table_base const* table, blob_cursor& data);
 
         ElementType ClassOrValueType() const noexcept
         {
@@ -123,25 +209,29 @@ namespace xlang::meta::reader
         std::vector<TypeSig> m_generic_args;
     };
 
-    inline std::vector<CustomModSig> parse_cmods(table_base const* table, byte_view& data)
+    inline std::vector<CustomModSig> parse_cmods(table_base const* table, blob_cursor& data)
     {
         std::vector<CustomModSig> result;
+        data.check();
         auto cursor = data;
 
-        for (auto element_type = uncompress_enum<ElementType>(cursor);
+        for (auto element_type = cursor.read_enum<ElementType>();
             element_type == ElementType::CModOpt || element_type == ElementType::CModReqd;
-            element_type = uncompress_enum<ElementType>(cursor))
+            element_type = cursor.read_enum<ElementType>())
         {
             result.emplace_back(table, data);
+            data.check();
             cursor = data;
         }
         return result;
     }
 
-    inline bool parse_szarray(table_base const*, byte_view& data)
+    inline bool parse_szarray(table_base const*, blob_cursor& data)
     {
+        // Every type starts a new element of the blob.
+        data.check();
         auto cursor = data;
-        if (uncompress_enum<ElementType>(cursor) == ElementType::SZArray)
+        if (cursor.read_enum<ElementType>() == ElementType::SZArray)
         {
             data = cursor;
             return true;
@@ -162,7 +252,7 @@ namespace xlang::meta::reader
     struct TypeSig
     {
         using value_type = std::variant<ElementType, coded_index<TypeDefOrRef>, GenericTypeIndex, GenericTypeInstSig, GenericMethodTypeIndex>;
-        TypeSig(table_base const* table, byte_view& data)
+        TypeSig(table_base const* table, blob_cursor& data)
             : m_is_szarray(parse_szarray(table, data))
             , m_cmod(parse_cmods(table, data))
             , m_element_type(parse_element_type(data))
@@ -185,23 +275,23 @@ namespace xlang::meta::reader
         }
 
     private:
-        static ElementType parse_element_type(byte_view& data)
+        static ElementType parse_element_type(blob_cursor& data)
         {
             auto cursor = data;
-            return uncompress_enum<ElementType>(cursor);
+            return cursor.read_enum<ElementType>();
         }
 
-        static value_type ParseType(table_base const* table, byte_view& data);
+        static value_type ParseType(table_base const* table, blob_cursor& data);
         bool m_is_szarray;
         std::vector<CustomModSig> m_cmod;
         ElementType m_element_type;
         value_type m_type;
     };
 
-    inline bool is_by_ref(byte_view& data)
+    inline bool is_by_ref(blob_cursor& data)
     {
         auto cursor = data;
-        auto element_type = uncompress_enum<ElementType>(cursor);
+        auto element_type = cursor.read_enum<ElementType>();
         if (element_type == ElementType::ByRef)
         {
             data = cursor;
@@ -216,7 +306,7 @@ namespace xlang::meta::reader
 
     struct ParamSig
     {
-        ParamSig(table_base const* table, byte_view& data)
+        ParamSig(table_base const* table, blob_cursor& data)
             : m_cmod(parse_cmods(table, data))
             , m_byref(is_by_ref(data))
             , m_type(table, data)
@@ -246,12 +336,12 @@ namespace xlang::meta::reader
 
     struct RetTypeSig
     {
-        RetTypeSig(table_base const* table, byte_view& data)
+        RetTypeSig(table_base const* table, blob_cursor& data)
             : m_cmod(parse_cmods(table, data))
             , m_byref(is_by_ref(data))
         {
             auto cursor = data;
-            auto element_type = uncompress_enum<ElementType>(cursor);
+            auto element_type = cursor.read_enum<ElementType>();
             if (element_type == ElementType::Void)
             {
                 data = cursor;
@@ -290,10 +380,10 @@ namespace xlang::meta::reader
 
     struct MethodDefSig
     {
-        MethodDefSig(table_base const* table, byte_view& data)
-            : m_calling_convention(uncompress_enum<CallingConvention>(data))
-            , m_generic_param_count(enum_mask(m_calling_convention, CallingConvention::Generic) == CallingConvention::Generic ? uncompress_unsigned(data) : 0)
-            , m_param_count(uncompress_unsigned(data))
+        MethodDefSig(table_base const* table, blob_cursor& data)
+            : m_calling_convention(data.read_enum<CallingConvention>())
+            , m_generic_param_count(enum_mask(m_calling_convention, CallingConvention::Generic) == CallingConvention::Generic ? data.read_compressed() : 0)
+            , m_param_count(data.read_compressed())
             , m_ret_type(table, data)
         {
             if (m_param_count > data.size())
@@ -305,6 +395,8 @@ namespace xlang::meta::reader
             {
                 m_params.emplace_back(table, data);
             }
+
+            data.check();
         }
 
         CallingConvention CallConvention() const noexcept
@@ -337,11 +429,13 @@ namespace xlang::meta::reader
 
     struct FieldSig
     {
-        FieldSig(table_base const* table, byte_view& data)
+        FieldSig(table_base const* table, blob_cursor& data)
             : m_calling_convention(check_convention(data))
             , m_cmod(parse_cmods(table, data))
             , m_type(table, data)
-        {}
+        {
+            data.check();
+        }
 
         auto CustomMod() const noexcept
         {
@@ -354,9 +448,9 @@ namespace xlang::meta::reader
         }
 
     private:
-        static CallingConvention check_convention(byte_view& data)
+        static CallingConvention check_convention(blob_cursor& data)
         {
-            auto conv = read<CallingConvention>(data);
+            auto conv = static_cast<CallingConvention>(data.read_byte());
             if (enum_mask(conv, CallingConvention::Field) != CallingConvention::Field)
             {
                 throw_invalid("Invalid calling convention for field blob");
@@ -370,9 +464,9 @@ namespace xlang::meta::reader
 
     struct PropertySig
     {
-        PropertySig(table_base const* table, byte_view& data)
+        PropertySig(table_base const* table, blob_cursor& data)
             : m_calling_convention(check_convention(data))
-            , m_param_count(uncompress_unsigned(data))
+            , m_param_count(data.read_compressed())
             , m_cmod(parse_cmods(table, data))
             , m_type(table, data)
         {
@@ -385,6 +479,8 @@ namespace xlang::meta::reader
             {
                 m_params.emplace_back(table, data);
             }
+
+            data.check();
         }
 
         TypeSig const& Type() const noexcept
@@ -398,9 +494,9 @@ namespace xlang::meta::reader
         }
 
     private:
-        static CallingConvention check_convention(byte_view& data)
+        static CallingConvention check_convention(blob_cursor& data)
         {
-            auto conv = read<CallingConvention>(data);
+            auto conv = static_cast<CallingConvention>(data.read_byte());
             if (enum_mask(conv, CallingConvention::Property) != CallingConvention::Property)
             {
                 throw_invalid("Invalid calling convention for property blob");
@@ -416,9 +512,10 @@ namespace xlang::meta::reader
 
     struct TypeSpecSig
     {
-        TypeSpecSig(table_base const* table, byte_view& data)
+        TypeSpecSig(table_base const* table, blob_cursor& data)
             : m_type(ParseType(table, data))
         {
+            data.check();
         }
 
         GenericTypeInstSig const& GenericTypeInst() const noexcept
@@ -427,19 +524,19 @@ namespace xlang::meta::reader
         }
 
     private:
-        static GenericTypeInstSig ParseType(table_base const* table, byte_view& data)
+        static GenericTypeInstSig ParseType(table_base const* table, blob_cursor& data)
         {
-            [[maybe_unused]] auto element_type = uncompress_enum<ElementType>(data);
+            [[maybe_unused]] auto element_type = data.read_enum<ElementType>();
             XLANG_ASSERT(element_type == ElementType::GenericInst);
             return { table, data };
         }
         GenericTypeInstSig m_type;
     };
 
-    inline GenericTypeInstSig::GenericTypeInstSig(table_base const* table, byte_view& data)
-        : m_class_or_value(uncompress_enum<ElementType>(data))
-        , m_type(table, uncompress_unsigned(data))
-        , m_generic_arg_count(uncompress_unsigned(data))
+    inline GenericTypeInstSig::GenericTypeInstSig(table_base const* table, blob_cursor& data)
+        : m_class_or_value(data.read_enum<ElementType>())
+        , m_type(table, data.read_compressed())
+        , m_generic_arg_count(data.read_compressed())
     {
         if (!(m_class_or_value == ElementType::Class || m_class_or_value == ElementType::ValueType))
         {
@@ -457,9 +554,9 @@ namespace xlang::meta::reader
         }
     }
 
-    inline TypeSig::value_type TypeSig::ParseType(table_base const* table, byte_view& data)
+    inline TypeSig::value_type TypeSig::ParseType(table_base const* table, blob_cursor& data)
     {
-        auto element_type = uncompress_enum<ElementType>(data);
+        auto element_type = data.read_enum<ElementType>();
         switch (element_type)
         {
         case ElementType::Boolean:
@@ -483,7 +580,7 @@ namespace xlang::meta::reader
 
         case ElementType::Class:
         case ElementType::ValueType:
-            return coded_index<TypeDefOrRef>{ table, uncompress_unsigned(data) };
+            return coded_index<TypeDefOrRef>{ table, data.read_compressed() };
             break;
 
         case ElementType::GenericInst:
@@ -491,11 +588,11 @@ namespace xlang::meta::reader
             break;
 
         case ElementType::Var:
-            return GenericTypeIndex{ uncompress_unsigned(data) };
+            return GenericTypeIndex{ data.read_compressed() };
             break;
 
         case ElementType::MVar:
-            return GenericMethodTypeIndex{ uncompress_unsigned(data) };
+            return GenericMethodTypeIndex{ data.read_compressed() };
             break;
 
         default:
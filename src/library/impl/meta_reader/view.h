@@ -1,3 +1,43 @@
+namespace xlang::impl
+{
+    // The length of a compressed integer from its first byte, or zero if the encoding is invalid.
+    constexpr uint32_t compressed_length(uint8_t const first) noexcept
+    {
+        // Indexed by the top three bits, since 0xxxxxxx, 10xxxxxx and 110xxxxx start one, two and
+        // four byte integers.
+        constexpr uint8_t lengths[8]{ 1, 1, 1, 1, 2, 2, 4, 0 };
+        return lengths[first >> 5];
+    }
+
+    // Decodes a compressed integer of a known length from data holding at least available bytes.
+    // With four bytes at hand they are read as one big-endian word and the unused bytes shifted
+    // away, so the decoding doesn't branch on the length.
+    inline uint32_t uncompress(uint8_t const* const data, uint32_t const length, uint32_t const available) noexcept
+    {
+        constexpr uint32_t masks[5]{ 0, 0x7f, 0x3fff, 0, 0x1fffffff };
+
+        if (available >= 4)
+        {
+            uint32_t const word = (uint32_t{ data[0] } << 24) | (uint32_t{ data[1] } << 16) | (uint32_t{ data[2] } << 8) | data[3];
+            return (word >> ((4 - length) * 8)) & masks[length];
+        }
+
+        uint32_t value{};
+
+        for (uint32_t i{}; i < length; ++i)
+        {
+            value = (value << 8) | data[i];
+        }
+
+        return value & masks[length];
+    }
+
+    static_assert(compressed_length(0x7f) == 1);
+    static_assert(compressed_length(0xbf) == 2);
+    static_assert(compressed_length(0xdf) == 4);
+    static_assert(compressed_length(0xff) == 0);
+}
+
 
 namespace xlang::meta::reader
 {
@@ -139,6 +179,83 @@ namespace xlang::meta::reader
         uint8_t const* m_last{};
     };
 
+    struct file_handle
+    {
+#if XLANG_PLATFORM_WINDOWS
+        using handle_type = HANDLE;
+#else
+        using handle_type = int;
+        static constexpr handle_type INVALID_HANDLE_VALUE = -1;
+#endif
+
+        handle_type value{ INVALID_HANDLE_VALUE };
+
+        file_handle(file_handle const&) = delete;
+        file_handle& operator=(file_handle const&) = delete;
+        file_handle& operator=(file_handle&&) = delete;
+
+        file_handle(file_handle&& other) noexcept : value{ std::exchange(other.value, INVALID_HANDLE_VALUE) }
+        {
+        }
+
+        explicit file_handle(handle_type const handle) noexcept : value{ handle }
+        {
+        }
+
+        ~file_handle() noexcept
+        {
+            if (value != INVALID_HANDLE_VALUE)
+            {
+#if XLANG_PLATFORM_WINDOWS
+                CloseHandle(value);
+#else
+                close(value);
+#endif
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return value != INVALID_HANDLE_VALUE;
+        }
+
+        // Opens the file for reading, throwing if it can't be opened.
+        static file_handle open(std::string_view const& path)
+        {
+#if XLANG_PLATFORM_WINDOWS
+            auto input = c_str(path);
+
+            auto const input_length = static_cast<uint32_t>(path.length() + 1);
+            int buffer_length = MultiByteToWideChar(CP_UTF8, 0, input, input_length, 0, 0);
+            std::vector<wchar_t> output = std::vector<wchar_t>(buffer_length);
+            int result = MultiByteToWideChar(CP_UTF8, 0, input, input_length, output.data(), buffer_length);
+
+            if (result == 0)
+            {
+                switch (GetLastError())
+                {
+                case ERROR_INSUFFICIENT_BUFFER:
+                    throw_invalid("Insufficient buffer size");
+                case ERROR_NO_UNICODE_TRANSLATION:
+                    throw_invalid("Untranslatable path");
+                default:
+                    throw_invalid("Could not convert path");
+                }
+            }
+
+            file_handle file{ CreateFile2(output.data(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr) };
+#else
+            file_handle file{ ::open(c_str(path), O_RDONLY, 0) };
+#endif
+            if (!file)
+            {
+                throw_invalid("Could not open file '", path, "'");
+            }
+
+            return file;
+        }
+    };
+
     struct file_view : byte_view
     {
         file_view(file_view const&) = delete;
@@ -166,6 +283,12 @@ namespace xlang::meta::reader
             }
         }
 
+        // Whether the view maps a file, rather than a buffer owned by someone else.
+        bool backed_by_file() const noexcept
+        {
+            return m_backed_by_file;
+        }
+
     private:
 
         bool m_backed_by_file;
@@ -190,65 +313,10 @@ namespace xlang::meta::reader
         };
 #endif
 
-        struct file_handle
-        {
-#if XLANG_PLATFORM_WINDOWS
-            using handle_type = HANDLE;
-#else
-            using handle_type = int;
-            static constexpr handle_type INVALID_HANDLE_VALUE = -1;
-#endif
-
-            handle_type value{ INVALID_HANDLE_VALUE };
-
-            ~file_handle() noexcept
-            {
-                if (value != INVALID_HANDLE_VALUE)
-                {
-#if XLANG_PLATFORM_WINDOWS
-                    CloseHandle(value);
-#else
-                    close(value);
-#endif
-                }
-            }
-
-            explicit operator bool() const noexcept
-            {
-                return value != INVALID_HANDLE_VALUE;
-            }
-        };
-
         static byte_view open_file(std::string_view const& path)
         {
+            file_handle file = file_handle::open(path);
 #if XLANG_PLATFORM_WINDOWS
-            auto input = c_str(path);
-
-            auto const input_length = static_cast<uint32_t>(path.length() + 1);
-            int buffer_length = MultiByteToWideChar(CP_UTF8, 0, input, input_length, 0, 0);
-            std::vector<wchar_t> output = std::vector<wchar_t>(buffer_length);
-            int result = MultiByteToWideChar(CP_UTF8, 0, input, input_length, output.data(), buffer_length);
-
-            if (result == 0)
-            {
-                switch (GetLastError())
-                {
-                case ERROR_INSUFFICIENT_BUFFER:
-                    throw_invalid("Insufficient buffer size");
-                case ERROR_NO_UNICODE_TRANSLATION:
-                    throw_invalid("Untranslatable path");
-                default:
-                    throw_invalid("Could not convert path");
-                }
-            }
-
-            file_handle file{ CreateFile2(output.data(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr) };
-
-            if (!file)
-            {
-                throw_invalid("Could not open file '", path, "'");
-            }
-
             LARGE_INTEGER size{};
             GetFileSizeEx(file.value, &size);
 
@@ -267,12 +335,6 @@ namespace xlang::meta::reader
             auto const first{ static_cast<uint8_t const*>(MapViewOfFile(mapping.value, FILE_MAP_READ, 0, 0, 0)) };
             return{ first, first + size.QuadPart };
 #else
-            file_handle file{ open(c_str(path), O_RDONLY, 0) };
-            if (!file)
-            {
-                throw_invalid("Could not open file '", path, "'");
-            }
-
             struct stat st;
             int ret = fstat(file.value, &st);
             if (ret < 0)
@@ -294,4 +356,48 @@ namespace xlang::meta::reader
 #endif
         }
     };
+
+    // Reads parts of a file at given offsets without mapping it, for when only a few headers are needed.
+    struct file_reader
+    {
+        explicit file_reader(std::string_view const& path) : m_file{ file_handle::open(path) }
+        {
+        }
+
+        // Returns false if the file ends before size bytes have been read.
+        bool read(uint32_t const offset, void* const buffer, uint32_t const size) const noexcept
+        {
+#if XLANG_PLATFORM_WINDOWS
+            OVERLAPPED overlapped{};
+            overlapped.Offset = offset;
+            DWORD read{};
+            return ReadFile(m_file.value, buffer, size, &read, &overlapped) && read == size;
+#else
+            uint32_t total{};
+
+            while (total < size)
+            {
+                ssize_t const read = pread(m_file.value, static_cast<uint8_t*>(buffer) + total, size - total, static_cast<off_t>(offset) + total);
+
+                if (read < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (read <= 0)
+                {
+                    return false;
+                }
+
+                total += static_cast<uint32_t>(read);
+            }
+
+            return true;
+#endif
+        }
+
+    private:
+
+        file_handle m_file;
+    };
 }
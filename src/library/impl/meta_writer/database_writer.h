@@ -0,0 +1,615 @@
+#pragma once
+
+#include "pe_writer.h"
+#include "../meta_reader/enum.h"
+#include <unordered_map>
+
+namespace xlang::meta::writer
+{
+    enum class table_id : uint8_t
+    {
+        Module = 0x00,
+        TypeRef = 0x01,
+        TypeDef = 0x02,
+        Field = 0x04,
+        MethodDef = 0x06,
+        Param = 0x08,
+        InterfaceImpl = 0x09,
+        MemberRef = 0x0a,
+        Constant = 0x0b,
+        CustomAttribute = 0x0c,
+        FieldMarshal = 0x0d,
+        DeclSecurity = 0x0e,
+        ClassLayout = 0x0f,
+        FieldLayout = 0x10,
+        StandAloneSig = 0x11,
+        EventMap = 0x12,
+        Event = 0x14,
+        PropertyMap = 0x15,
+        Property = 0x17,
+        MethodSemantics = 0x18,
+        MethodImpl = 0x19,
+        ModuleRef = 0x1a,
+        TypeSpec = 0x1b,
+        ImplMap = 0x1c,
+        FieldRVA = 0x1d,
+        Assembly = 0x20,
+        AssemblyProcessor = 0x21,
+        AssemblyOS = 0x22,
+        AssemblyRef = 0x23,
+        AssemblyRefProcessor = 0x24,
+        AssemblyRefOS = 0x25,
+        File = 0x26,
+        ExportedType = 0x27,
+        ManifestResource = 0x28,
+        NestedClass = 0x29,
+        GenericParam = 0x2a,
+        MethodSpec = 0x2b,
+        GenericParamConstraint = 0x2c,
+    };
+
+    // Encodes a coded index from its tag and a one-based row number.
+    template <typename T>
+    constexpr uint32_t make_coded_index(T const type, uint32_t const row) noexcept
+    {
+        return (row << reader::coded_index_bits_v<T>) | static_cast<uint32_t>(type);
+    }
+
+    // Builds the tables and heaps of a metadata database in memory. Rows are added with one value per
+    // column: constants as they are, strings, blobs and GUIDs as the indexes returned by add_string,
+    // add_blob and add_guid, table indexes as one-based row numbers and coded indexes as produced by
+    // make_coded_index. Column widths are chosen when the database is saved, using the same rules as
+    // database::initialize.
+    //
+    // Tables whose rows are not referenced by other tables are sorted by their primary key when
+    // saved. InterfaceImpl, GenericParam and GenericParamConstraint rows must be added in key order.
+    struct database_writer
+    {
+        database_writer()
+        {
+            m_strings.push_back(0);
+            m_blobs.push_back(0);
+        }
+
+        uint32_t add_string(std::string_view const& value)
+        {
+            if (value.empty())
+            {
+                return 0;
+            }
+
+            auto [existing, inserted] = m_string_index.try_emplace(std::string{ value }, static_cast<uint32_t>(m_strings.size()));
+
+            if (inserted)
+            {
+                m_strings.insert(m_strings.end(), value.begin(), value.end());
+                m_strings.push_back(0);
+            }
+
+            return existing->second;
+        }
+
+        uint32_t add_blob(uint8_t const* const first, uint8_t const* const last)
+        {
+            if (first == last)
+            {
+                return 0;
+            }
+
+            auto [existing, inserted] = m_blob_index.try_emplace(std::string{ first, last }, static_cast<uint32_t>(m_blobs.size()));
+
+            if (inserted)
+            {
+                write_compressed(m_blobs, static_cast<uint32_t>(last - first));
+                m_blobs.insert(m_blobs.end(), first, last);
+            }
+
+            return existing->second;
+        }
+
+        uint32_t add_blob(std::vector<uint8_t> const& value)
+        {
+            return add_blob(value.data(), value.data() + value.size());
+        }
+
+        // Returns the one-based index of the GUID.
+        uint32_t add_guid(std::array<uint8_t, 16> const& value)
+        {
+            auto [existing, inserted] = m_guid_index.try_emplace(std::string{ value.begin(), value.end() }, static_cast<uint32_t>(m_guids.size() / 16 + 1));
+
+            if (inserted)
+            {
+                m_guids.insert(m_guids.end(), value.begin(), value.end());
+            }
+
+            return existing->second;
+        }
+
+        // Returns the one-based row number of the new row.
+        uint32_t add_row(table_id const table, std::initializer_list<uint64_t> const values)
+        {
+            auto& rows = m_tables[static_cast<uint8_t>(table)];
+
+            if (values.size() != column_count(table))
+            {
+                throw_invalid("Wrong number of columns for metadata table");
+            }
+
+            rows.insert(rows.end(), values.begin(), values.end());
+            return row_count(table);
+        }
+
+        // Updates a value of a row that was already added, such as a list that could only be
+        // filled in once the rows it refers to were added.
+        void set_value(table_id const table, uint32_t const row, uint32_t const column, uint64_t const value)
+        {
+            if (row == 0 || row > row_count(table) || column >= column_count(table))
+            {
+                throw_invalid("Metadata table row or column out of range");
+            }
+
+            m_tables[static_cast<uint8_t>(table)][(row - 1) * column_count(table) + column] = value;
+        }
+
+        uint32_t row_count(table_id const table) const noexcept
+        {
+            return static_cast<uint32_t>(m_tables[static_cast<uint8_t>(table)].size() / column_count(table));
+        }
+
+        // The version string recorded in the metadata root.
+        void version(std::string_view const& value)
+        {
+            m_version = value;
+        }
+
+        std::vector<uint8_t> save_metadata()
+        {
+            sort_tables();
+
+            auto const tables = save_tables();
+            std::vector<uint8_t> user_strings{ 0, 0, 0, 0 };
+
+            std::array<std::pair<std::string_view, std::vector<uint8_t> const*>, 5> const streams
+            { {
+                { "#~", &tables },
+                { "#Strings", &m_strings },
+                { "#US", &user_strings },
+                { "#GUID", &m_guids },
+                { "#Blob", &m_blobs },
+            } };
+
+            uint32_t const version_length = round_up(static_cast<uint32_t>(m_version.size() + 1), 4);
+            uint32_t header_size = 20 + version_length;
+
+            for (auto&& [name, data] : streams)
+            {
+                header_size += stream_header_size(name);
+            }
+
+            // Aligning the first stream lets the reader load the 64-bit table masks directly.
+            header_size = round_up(header_size, 8);
+
+            std::vector<uint8_t> result;
+            write_value(result, uint32_t{ 0x424a5342 }); // BSJB
+            write_value(result, uint16_t{ 1 });
+            write_value(result, uint16_t{ 1 });
+            write_value(result, uint32_t{});
+            write_value(result, version_length);
+            result.insert(result.end(), m_version.begin(), m_version.end());
+            result.resize(16 + version_length);
+            write_value(result, uint16_t{});
+            write_value(result, static_cast<uint16_t>(streams.size()));
+
+            uint32_t offset = header_size;
+
+            for (auto&& [name, data] : streams)
+            {
+                uint32_t const size = round_up(static_cast<uint32_t>(data->size()), 4);
+                write_value(result, offset);
+                write_value(result, size);
+                result.insert(result.end(), name.begin(), name.end());
+                result.resize(result.size() + stream_header_size(name) - 8 - name.size());
+                offset += size;
+            }
+
+            result.resize(header_size);
+
+            for (auto&& [name, data] : streams)
+            {
+                result.insert(result.end(), data->begin(), data->end());
+                result.resize(round_up(static_cast<uint32_t>(result.size()), 4));
+            }
+
+            return result;
+        }
+
+        std::vector<uint8_t> save_to_memory()
+        {
+            pe_writer writer;
+            writer.add_metadata(save_metadata());
+            return writer.save_to_memory();
+        }
+
+        void save_to_file(std::filesystem::path const& path)
+        {
+            std::ofstream output{ path, std::ios::binary };
+            auto const image = save_to_memory();
+            output.write(reinterpret_cast<char const*>(image.data()), image.size());
+        }
+
+    private:
+
+        enum class column_type : uint8_t
+        {
+            none,
+            constant2,
+            constant4,
+            constant8,
+            string,
+            guid,
+            blob,
+            index,
+            coded,
+        };
+
+        enum class coded_type : uint8_t
+        {
+            TypeDefOrRef,
+            HasConstant,
+            HasCustomAttribute,
+            HasFieldMarshal,
+            HasDeclSecurity,
+            MemberRefParent,
+            HasSemantics,
+            MethodDefOrRef,
+            MemberForwarded,
+            Implementation,
+            CustomAttributeType,
+            ResolutionScope,
+            TypeOrMethodDef,
+        };
+
+        struct column
+        {
+            column_type type;
+            uint8_t target;
+        };
+
+        using schema = std::array<column, 6>;
+
+        static constexpr column c2{ column_type::constant2, 0 };
+        static constexpr column c4{ column_type::constant4, 0 };
+        static constexpr column c8{ column_type::constant8, 0 };
+        static constexpr column s{ column_type::string, 0 };
+        static constexpr column g{ column_type::guid, 0 };
+        static constexpr column b{ column_type::blob, 0 };
+
+        static constexpr column index(table_id const table) noexcept
+        {
+            return { column_type::index, static_cast<uint8_t>(table) };
+        }
+
+        static constexpr column coded(coded_type const type) noexcept
+        {
+            return { column_type::coded, static_cast<uint8_t>(type) };
+        }
+
+        static schema const& get_schema(table_id const table) noexcept
+        {
+            static std::array<schema, 64> const schemas = []
+            {
+                std::array<schema, 64> result{};
+                auto set = [&](table_id const id, schema const& columns) { result[static_cast<uint8_t>(id)] = columns; };
+
+                set(table_id::Module, { c2, s, g, g, g });
+                set(table_id::TypeRef, { coded(coded_type::ResolutionScope), s, s });
+                set(table_id::TypeDef, { c4, s, s, coded(coded_type::TypeDefOrRef), index(table_id::Field), index(table_id::MethodDef) });
+                set(table_id::Field, { c2, s, b });
+                set(table_id::MethodDef, { c4, c2, c2, s, b, index(table_id::Param) });
+                set(table_id::Param, { c2, c2, s });
+                set(table_id::InterfaceImpl, { index(table_id::TypeDef), coded(coded_type::TypeDefOrRef) });
+                set(table_id::MemberRef, { coded(coded_type::MemberRefParent), s, b });
+                set(table_id::Constant, { c2, coded(coded_type::HasConstant), b });
+                set(table_id::CustomAttribute, { coded(coded_type::HasCustomAttribute), coded(coded_type::CustomAttributeType), b });
+                set(table_id::FieldMarshal, { coded(coded_type::HasFieldMarshal), b });
+                set(table_id::DeclSecurity, { c2, coded(coded_type::HasDeclSecurity), b });
+                set(table_id::ClassLayout, { c2, c4, index(table_id::TypeDef) });
+                set(table_id::FieldLayout, { c4, index(table_id::Field) });
+                set(table_id::StandAloneSig, { b });
+                set(table_id::EventMap, { index(table_id::TypeDef), index(table_id::Event) });
+                set(table_id::Event, { c2, s, coded(coded_type::TypeDefOrRef) });
+                set(table_id::PropertyMap, { index(table_id::TypeDef), index(table_id::Property) });
+                set(table_id::Property, { c2, s, b });
+                set(table_id::MethodSemantics, { c2, index(table_id::MethodDef), coded(coded_type::HasSemantics) });
+                set(table_id::MethodImpl, { index(table_id::TypeDef), coded(coded_type::MethodDefOrRef), coded(coded_type::MethodDefOrRef) });
+                set(table_id::ModuleRef, { s });
+                set(table_id::TypeSpec, { b });
+                set(table_id::ImplMap, { c2, coded(coded_type::MemberForwarded), s, index(table_id::ModuleRef) });
+                set(table_id::FieldRVA, { c4, index(table_id::Field) });
+                set(table_id::Assembly, { c4, c8, c4, b, s, s });
+                set(table_id::AssemblyProcessor, { c4 });
+                set(table_id::AssemblyOS, { c4, c4, c4 });
+                set(table_id::AssemblyRef, { c8, c4, b, s, s, b });
+                set(table_id::AssemblyRefProcessor, { c4, index(table_id::AssemblyRef) });
+                set(table_id::AssemblyRefOS, { c4, c4, c4, index(table_id::AssemblyRef) });
+                set(table_id::File, { c4, s, b });
+                set(table_id::ExportedType, { c4, c4, s, s, coded(coded_type::Implementation) });
+                set(table_id::ManifestResource, { c4, c4, s, coded(coded_type::Implementation) });
+                set(table_id::NestedClass, { index(table_id::TypeDef), index(table_id::TypeDef) });
+                set(table_id::GenericParam, { c2, c2, coded(coded_type::TypeOrMethodDef), s });
+                set(table_id::MethodSpec, { coded(coded_type::MethodDefOrRef), b });
+                set(table_id::GenericParamConstraint, { index(table_id::GenericParam), coded(coded_type::TypeDefOrRef) });
+
+                return result;
+            }();
+
+            return schemas[static_cast<uint8_t>(table)];
+        }
+
+        static uint32_t column_count(table_id const table) noexcept
+        {
+            auto const& columns = get_schema(table);
+            return static_cast<uint32_t>(std::find_if(columns.begin(), columns.end(), [](auto&& column) { return column.type == column_type::none; }) - columns.begin());
+        }
+
+        // The column that a sorted table is ordered by, or -1 if the table isn't sorted here.
+        static int32_t sort_column(table_id const table) noexcept
+        {
+            switch (table)
+            {
+            case table_id::FieldMarshal:
+            case table_id::CustomAttribute:
+            case table_id::MethodImpl:
+            case table_id::NestedClass:
+                return 0;
+            case table_id::Constant:
+            case table_id::DeclSecurity:
+            case table_id::FieldLayout:
+            case table_id::ImplMap:
+            case table_id::FieldRVA:
+                return 1;
+            case table_id::ClassLayout:
+            case table_id::MethodSemantics:
+                return 2;
+            default:
+                return -1;
+            }
+        }
+
+        static constexpr uint64_t sorted_tables =
+            (1ull << static_cast<uint8_t>(table_id::InterfaceImpl)) |
+            (1ull << static_cast<uint8_t>(table_id::Constant)) |
+            (1ull << static_cast<uint8_t>(table_id::CustomAttribute)) |
+            (1ull << static_cast<uint8_t>(table_id::FieldMarshal)) |
+            (1ull << static_cast<uint8_t>(table_id::DeclSecurity)) |
+            (1ull << static_cast<uint8_t>(table_id::ClassLayout)) |
+            (1ull << static_cast<uint8_t>(table_id::FieldLayout)) |
+            (1ull << static_cast<uint8_t>(table_id::MethodSemantics)) |
+            (1ull << static_cast<uint8_t>(table_id::MethodImpl)) |
+            (1ull << static_cast<uint8_t>(table_id::ImplMap)) |
+            (1ull << static_cast<uint8_t>(table_id::FieldRVA)) |
+            (1ull << static_cast<uint8_t>(table_id::NestedClass)) |
+            (1ull << static_cast<uint8_t>(table_id::GenericParam)) |
+            (1ull << static_cast<uint8_t>(table_id::GenericParamConstraint));
+
+        struct coded_index_tables
+        {
+            uint32_t bits;
+            std::vector<table_id> tables;
+        };
+
+        // The tag widths come from the reader so that both agree on when a coded index needs four bytes.
+        static coded_index_tables const& get_coded_tables(coded_type const type)
+        {
+            using namespace reader;
+
+            static std::array<coded_index_tables, 13> const tables
+            { {
+                { coded_index_bits_v<TypeDefOrRef>, { table_id::TypeDef, table_id::TypeRef, table_id::TypeSpec } },
+                { coded_index_bits_v<HasConstant>, { table_id::Field, table_id::Param, table_id::Property } },
+                { coded_index_bits_v<HasCustomAttribute>, { table_id::MethodDef, table_id::Field, table_id::TypeRef, table_id::TypeDef, table_id::Param, table_id::InterfaceImpl, table_id::MemberRef, table_id::Module, table_id::Property, table_id::Event, table_id::StandAloneSig, table_id::ModuleRef, table_id::TypeSpec, table_id::Assembly, table_id::AssemblyRef, table_id::File, table_id::ExportedType, table_id::ManifestResource, table_id::GenericParam, table_id::GenericParamConstraint, table_id::MethodSpec } },
+                { coded_index_bits_v<HasFieldMarshal>, { table_id::Field, table_id::Param } },
+                { coded_index_bits_v<HasDeclSecurity>, { table_id::TypeDef, table_id::MethodDef, table_id::Assembly } },
+                { coded_index_bits_v<MemberRefParent>, { table_id::TypeDef, table_id::TypeRef, table_id::ModuleRef, table_id::MethodDef, table_id::TypeSpec } },
+                { coded_index_bits_v<HasSemantics>, { table_id::Event, table_id::Property } },
+                { coded_index_bits_v<MethodDefOrRef>, { table_id::MethodDef, table_id::MemberRef } },
+                { coded_index_bits_v<MemberForwarded>, { table_id::Field, table_id::MethodDef } },
+                { coded_index_bits_v<Implementation>, { table_id::File, table_id::AssemblyRef, table_id::ExportedType } },
+                { coded_index_bits_v<CustomAttributeType>, { table_id::MethodDef, table_id::MemberRef } },
+                { coded_index_bits_v<ResolutionScope>, { table_id::Module, table_id::ModuleRef, table_id::AssemblyRef, table_id::TypeRef } },
+                { coded_index_bits_v<TypeOrMethodDef>, { table_id::TypeDef, table_id::MethodDef } },
+            } };
+
+            return tables[static_cast<uint8_t>(type)];
+        }
+
+        uint8_t column_size(column const& column, std::array<uint8_t, 3> const& heap_sizes) const noexcept
+        {
+            switch (column.type)
+            {
+            case column_type::constant2: return 2;
+            case column_type::constant4: return 4;
+            case column_type::constant8: return 8;
+            case column_type::string: return heap_sizes[0];
+            case column_type::guid: return heap_sizes[1];
+            case column_type::blob: return heap_sizes[2];
+            case column_type::index: return row_count(static_cast<table_id>(column.target)) < (1 << 16) ? 2 : 4;
+            case column_type::coded:
+            {
+                auto const& coded = get_coded_tables(static_cast<coded_type>(column.target));
+
+                for (auto&& table : coded.tables)
+                {
+                    if (row_count(table) >= (1ull << (16 - coded.bits)))
+                    {
+                        return 4;
+                    }
+                }
+
+                return 2;
+            }
+            default: return 0;
+            }
+        }
+
+        // Orders the rows of the tables listed by sort_column by their key, keeping the order in
+        // which rows with the same key were added.
+        void sort_tables()
+        {
+            for (uint8_t id{}; id < 64; ++id)
+            {
+                auto const table = static_cast<table_id>(id);
+                int32_t const key = sort_column(table);
+
+                if (key < 0 || m_tables[id].empty())
+                {
+                    continue;
+                }
+
+                uint32_t const columns = column_count(table);
+                auto& values = m_tables[id];
+                std::vector<uint32_t> order(row_count(table));
+
+                for (uint32_t row{}; row < order.size(); ++row)
+                {
+                    order[row] = row;
+                }
+
+                std::stable_sort(order.begin(), order.end(), [&](uint32_t const left, uint32_t const right)
+                {
+                    return values[left * columns + key] < values[right * columns + key];
+                });
+
+                std::vector<uint64_t> sorted;
+                sorted.reserve(values.size());
+
+                for (uint32_t const row : order)
+                {
+                    sorted.insert(sorted.end(), values.begin() + row * columns, values.begin() + (row + 1) * columns);
+                }
+
+                values = std::move(sorted);
+            }
+        }
+
+        std::vector<uint8_t> save_tables() const
+        {
+            std::array<uint8_t, 3> const heap_sizes
+            {
+                static_cast<uint8_t>(m_strings.size() < (1 << 16) ? 2 : 4),
+                static_cast<uint8_t>(m_guids.size() < (1 << 16) ? 2 : 4),
+                static_cast<uint8_t>(m_blobs.size() < (1 << 16) ? 2 : 4),
+            };
+
+            uint64_t valid{};
+
+            for (uint8_t id{}; id < 64; ++id)
+            {
+                if (!m_tables[id].empty())
+                {
+                    valid |= 1ull << id;
+                }
+            }
+
+            std::vector<uint8_t> result;
+            write_value(result, uint32_t{});
+            write_value(result, uint8_t{ 2 });
+            write_value(result, uint8_t{ 0 });
+            write_value(result, static_cast<uint8_t>((heap_sizes[0] == 4 ? 1 : 0) | (heap_sizes[1] == 4 ? 2 : 0) | (heap_sizes[2] == 4 ? 4 : 0)));
+            write_value(result, uint8_t{ 1 });
+            write_value(result, valid);
+            write_value(result, sorted_tables);
+
+            for (uint8_t id{}; id < 64; ++id)
+            {
+                if (!m_tables[id].empty())
+                {
+                    write_value(result, row_count(static_cast<table_id>(id)));
+                }
+            }
+
+            for (uint8_t id{}; id < 64; ++id)
+            {
+                if (m_tables[id].empty())
+                {
+                    continue;
+                }
+
+                auto const& columns = get_schema(static_cast<table_id>(id));
+                uint32_t const count = column_count(static_cast<table_id>(id));
+                std::array<uint8_t, 6> sizes{};
+
+                for (uint32_t column{}; column < count; ++column)
+                {
+                    sizes[column] = column_size(columns[column], heap_sizes);
+                }
+
+                for (size_t value{}; value < m_tables[id].size(); ++value)
+                {
+                    write_bytes(result, m_tables[id][value], sizes[value % count]);
+                }
+            }
+
+            return result;
+        }
+
+        static uint32_t round_up(uint32_t const size, uint32_t const alignment) noexcept
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        static uint32_t stream_header_size(std::string_view const& name) noexcept
+        {
+            return 8 + round_up(static_cast<uint32_t>(name.size() + 1), 4);
+        }
+
+        template <typename T>
+        static void write_value(std::vector<uint8_t>& output, T const value)
+        {
+            write_bytes(output, value, sizeof(T));
+        }
+
+        // Writes the low size bytes of value in little-endian order.
+        static void write_bytes(std::vector<uint8_t>& output, uint64_t value, uint8_t const size)
+        {
+            for (uint8_t i{}; i < size; ++i)
+            {
+                output.push_back(static_cast<uint8_t>(value));
+                value >>= 8;
+            }
+        }
+
+        static void write_compressed(std::vector<uint8_t>& output, uint32_t const value)
+        {
+            if (value < 0x80)
+            {
+                output.push_back(static_cast<uint8_t>(value));
+            }
+            else if (value < 0x4000)
+            {
+                output.push_back(static_cast<uint8_t>(0x80 | (value >> 8)));
+                output.push_back(static_cast<uint8_t>(value));
+            }
+            else if (value < 0x20000000)
+            {
+                output.push_back(static_cast<uint8_t>(0xc0 | (value >> 24)));
+                output.push_back(static_cast<uint8_t>(value >> 16));
+                output.push_back(static_cast<uint8_t>(value >> 8));
+                output.push_back(static_cast<uint8_t>(value));
+            }
+            else
+            {
+                throw_invalid("Blob is too large");
+            }
+        }
+
+        std::array<std::vector<uint64_t>, 64> m_tables;
+        std::vector<uint8_t> m_strings;
+        std::vector<uint8_t> m_blobs;
+        std::vector<uint8_t> m_guids;
+        std::unordered_map<std::string, uint32_t> m_string_index;
+        std::unordered_map<std::string, uint32_t> m_blob_index;
+        std::unordered_map<std::string, uint32_t> m_guid_index;
+        std::string m_version{ "WindowsRuntime 1.4" };
+    };
+}
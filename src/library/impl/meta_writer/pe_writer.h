@@ -293,7 +293,7 @@ namespace xlang::meta::writer
             uint32_t const raw_header_size = get_raw_end_of_headers();
             {
                 auto dos_header = get_dos_header();
-                dos_header->e_magic = 0x5a4d; // "MZ
+                dos_header->e_signature = 0x5a4d; // "MZ
                 dos_header->e_lfanew = nt_header_offset;
             }
             {
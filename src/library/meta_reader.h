@@ -3,6 +3,7 @@
 #include "impl/base.h"
 #include "impl/meta_reader/pe.h"
 #include "impl/meta_reader/view.h"
+#include "impl/meta_reader/memory_report.h"
 #include "impl/meta_reader/enum.h"
 #include "impl/meta_reader/enum_traits.h"
 #include "impl/meta_reader/flags.h"
@@ -15,6 +16,8 @@
 #include "impl/meta_reader/type_helpers.h"
 #include "impl/meta_reader/key.h"
 #include "impl/meta_reader/cache.h"
+#include "impl/meta_reader/cache_watcher.h"
+#include "impl/meta_reader/shared_cache.h"
 #include "impl/meta_reader/filter.h"
 #include "impl/meta_reader/custom_attribute.h"
 #include "impl/meta_reader/helpers.h"
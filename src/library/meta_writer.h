@@ -1,3 +1,4 @@
 #pragma once
 
 #include "impl/meta_writer/pe_writer.h"
+#include "impl/meta_writer/database_writer.h"
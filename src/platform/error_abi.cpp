@@ -5,9 +5,41 @@
 
 namespace xlang::impl
 {
+    struct error_info;
+
+    // Errors are used for control flow by projections (failed lookups, out of bounds access, failed
+    // QueryInterface calls), so released error infos are kept on a small per-thread free list and
+    // reused by the next origination on that thread instead of going back to the heap.
+    struct error_info_free_list
+    {
+        static constexpr uint32_t max_count = 16;
+
+        ~error_info_free_list() noexcept;
+
+        void* pop() noexcept;
+        bool push(void* storage) noexcept;
+
+    private:
+        struct node
+        {
+            node* next;
+        };
+
+        node* m_head{};
+        uint32_t m_count{};
+    };
+
+    // Set once the current thread's free list has been destroyed. Errors released after that
+    // point (e.g. from other thread_local destructors) go straight back to the heap.
+    thread_local bool t_free_list_destroyed{};
+    thread_local error_info_free_list t_free_list;
+
+    std::atomic<xlang_error_mode> g_error_mode{ xlang_error_mode::full };
+
     struct error_info : xlang_error_info
     {
-        // Used to construct constant errors used in out of memory scenarios.
+        // Used to construct the immortal errors used in out of memory scenarios and for code-only
+        // errors in lightweight mode.
         explicit error_info(xlang_result result) noexcept :
             m_result{ result },
             m_modifiable{ false }
@@ -69,11 +101,52 @@ namespace xlang::impl
             auto result = --m_count;
             if (result == 0)
             {
-                delete this;
+                XLANG_ASSERT(m_modifiable);
+                recycle(this);
             }
             return result;
         }
 
+        static xlang_error_info* create(
+            xlang_result result,
+            xlang_string message,
+            xlang_string projection_identifier,
+            xlang_string language_error,
+            xlang_unknown* execution_trace,
+            xlang_unknown* language_information) noexcept
+        {
+            void* storage = t_free_list_destroyed ? nullptr : t_free_list.pop();
+            if (!storage)
+            {
+                storage = ::operator new(sizeof(error_info), std::nothrow);
+                if (!storage)
+                {
+                    return nullptr;
+                }
+            }
+
+            return new (storage) error_info
+            {
+                result,
+                message,
+                projection_identifier,
+                language_error,
+                execution_trace,
+                language_information
+            };
+        }
+
+        static void recycle(error_info* value) noexcept
+        {
+            // Destroying the error releases its strings and propagated errors, which may recycle
+            // further error infos. The storage is only pushed once it is no longer referenced.
+            value->~error_info();
+            if (t_free_list_destroyed || !t_free_list.push(value))
+            {
+                ::operator delete(value);
+            }
+        }
+
         void GetError(xlang_result* error) noexcept override
         {
             *error = m_result;
@@ -126,15 +199,20 @@ namespace xlang::impl
                 return;
             }
 
+            // Always create a modifiable error info here, since it gets linked into this propagation chain.
             com_ptr<xlang_error_info> propagated_error;
             propagated_error.attach(
-                xlang_originate_error(
+                create(
                     m_result,
                     get_abi(m_message),
                     projection_identifier,
                     language_error,
                     execution_trace,
                     language_information));
+            if (!propagated_error)
+            {
+                return;
+            }
 
             error_info* last_propagated_error = this;
             while (last_propagated_error->m_next_propagated_error != nullptr)
@@ -156,6 +234,7 @@ namespace xlang::impl
         atomic_ref_count m_count;
     };
 
+    // Indexed by xlang_result - 1, since xlang_result::success has no error info.
     error_info error_code_errors [] = {
         error_info {xlang_result::access_denied},
         error_info {xlang_result::bounds},
@@ -169,6 +248,48 @@ namespace xlang::impl
         error_info {xlang_result::pointer},
         error_info {xlang_result::type_load}
     };
+
+    error_info* get_error_code_error(xlang_result result) noexcept
+    {
+        auto const index = static_cast<uint32_t>(result) - 1;
+        if (index >= std::size(error_code_errors))
+        {
+            return &error_code_errors[static_cast<uint32_t>(xlang_result::fail) - 1];
+        }
+        return &error_code_errors[index];
+    }
+
+    error_info_free_list::~error_info_free_list() noexcept
+    {
+        t_free_list_destroyed = true;
+        while (m_head)
+        {
+            ::operator delete(std::exchange(m_head, m_head->next));
+        }
+        m_count = 0;
+    }
+
+    void* error_info_free_list::pop() noexcept
+    {
+        if (!m_head)
+        {
+            return nullptr;
+        }
+        --m_count;
+        return std::exchange(m_head, m_head->next);
+    }
+
+    bool error_info_free_list::push(void* storage) noexcept
+    {
+        if (m_count == max_count)
+        {
+            return false;
+        }
+        static_assert(sizeof(node) <= sizeof(error_info));
+        m_head = new (storage) node{ m_head };
+        ++m_count;
+        return true;
+    }
 }
 
 [[nodiscard]] XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_originate_error(
@@ -180,23 +301,37 @@ namespace xlang::impl
     xlang_unknown* language_information
 ) XLANG_NOEXCEPT
 {
-    xlang_error_info* error_info =
-        new (std::nothrow) xlang::impl::error_info
+    using namespace xlang::impl;
+
+    // In lightweight mode, errors that carry nothing but their code share an immortal error info.
+    // The projection identifier alone doesn't describe the error, so it is dropped in this case.
+    if (g_error_mode.load(std::memory_order_relaxed) == xlang_error_mode::lightweight &&
+        !message && !language_error && !execution_trace && !language_information)
     {
+        xlang_error_info* result = get_error_code_error(error);
+        result->AddRef();
+        return result;
+    }
+
+    xlang_error_info* result = error_info::create(
         error,
         message,
         projection_identifier,
         language_error,
         execution_trace,
-        language_information
-    };
+        language_information);
 
     // If failed to construct, use the statically allocated ones.
-    if (error_info == nullptr)
+    if (result == nullptr)
     {
-        error_info = &xlang::impl::error_code_errors[static_cast<int>(error)];
-        error_info->AddRef();
+        result = get_error_code_error(error);
+        result->AddRef();
     }
 
-    return error_info;
+    return result;
+}
+
+XLANG_PAL_EXPORT xlang_error_mode XLANG_CALL xlang_set_error_mode(xlang_error_mode mode) XLANG_NOEXCEPT
+{
+    return xlang::impl::g_error_mode.exchange(mode, std::memory_order_relaxed);
 }
\ No newline at end of file
@@ -9,6 +9,14 @@ namespace xlang::impl
 {
     struct cache_string;
 
+    // Short strings are allocated from a per-thread cache of fixed-size blocks, which saves a heap
+    // round trip for the property names and enum values that make up most string traffic. A block
+    // released on another thread goes to that thread's cache.
+    inline constexpr uint32_t small_string_block_size = 64;
+
+    void* allocate_small_string_block() noexcept;
+    void free_small_string_block(void* block) noexcept;
+
     struct heap_string : string_base
     {
         int32_t addref() noexcept;
@@ -28,6 +36,10 @@ namespace xlang::impl
         template <typename char_type>
         static heap_string* create_preallocated(uint32_t length);
 
+        // Returns the process-wide instance for a single ASCII character string.
+        template <typename char_type>
+        static heap_string* get_immortal(char_type value) noexcept;
+
         heap_string* promote_preallocated(uint32_t length);
         void free_preallocated();
 
@@ -47,7 +59,8 @@ namespace xlang::impl
         heap_string(
             char_type const* source_string,
             uint32_t length,
-            char_type* char_storage
+            char_type* char_storage,
+            string_flags new_flags = string_flags::none
         ) noexcept;
 
         ~heap_string() noexcept;
@@ -75,6 +88,10 @@ namespace xlang::impl
         {
             return nullptr;
         }
+        if (length == 1 && static_cast<uint32_t>(source_string[0]) < 0x80)
+        {
+            return get_immortal(source_string[0]);
+        }
         return create_impl(source_string, length, nullptr);
     }
 
@@ -88,6 +105,11 @@ namespace xlang::impl
         {
             return nullptr;
         }
+        // Keep sharing an existing alternate form rather than switching to the immortal instance.
+        if (!alternate && length == 1 && static_cast<uint32_t>(source_string[0]) < 0x80)
+        {
+            return get_immortal(source_string[0]);
+        }
         return create_impl(source_string, length, alternate);
     }
 
@@ -99,6 +121,33 @@ namespace xlang::impl
         return result;
     }
 
+    template <typename char_type>
+    heap_string* heap_string::get_immortal(char_type value) noexcept
+    {
+        static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>, "char_t must be either xlang_char8 or char16_t");
+        XLANG_ASSERT(static_cast<uint32_t>(value) < 0x80);
+
+        // One entry per ASCII character, each holding the string header followed by the character
+        // and its null terminator. The instances are never destroyed, nor are the alternate forms
+        // cached on them.
+        constexpr size_t entry_size = (sizeof(heap_string) + 2 * sizeof(char_type) + alignof(heap_string) - 1) & ~(alignof(heap_string) - 1);
+        constexpr size_t entry_count = 0x80;
+        alignas(heap_string) static uint8_t storage[entry_count * entry_size];
+        static bool const initialized = []
+        {
+            for (size_t i = 0; i < entry_count; ++i)
+            {
+                auto entry = reinterpret_cast<heap_string*>(storage + i * entry_size);
+                char_type const source = static_cast<char_type>(i);
+                new (entry) heap_string(&source, 1, get_packed_buffer_ptr<heap_string, char_type>(entry), string_flags::is_immortal);
+            }
+            return true;
+        }();
+        static_cast<void>(initialized);
+
+        return reinterpret_cast<heap_string*>(storage + static_cast<size_t>(value) * entry_size);
+    }
+
     inline cache_string const* heap_string::get_alternate() const noexcept
     {
         return this->get_alternate_ptr<cache_string>();
@@ -130,12 +179,13 @@ namespace xlang::impl
     inline heap_string::heap_string(
         char_type const* source_string,
         uint32_t length,
-        char_type* char_storage
+        char_type* char_storage,
+        string_flags new_flags
     ) noexcept
         : string_base(
             char_storage,
             length,
-            !source_string ? string_flags::is_preallocated_string_buffer : string_flags::none
+            !source_string ? string_flags::is_preallocated_string_buffer : new_flags
         )
     {
         static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>, "char_t must be either xlang_char8 or char16_t");
@@ -208,11 +258,20 @@ namespace xlang::impl
 
     inline int32_t heap_string::addref() noexcept
     {
+        if (is_immortal())
+        {
+            return 2;
+        }
         return ++count;
     }
 
     inline int32_t heap_string::release() noexcept
     {
+        if (is_immortal())
+        {
+            return 1;
+        }
+
         auto const result = --count;
         if (result == 0)
         {
@@ -222,7 +281,14 @@ namespace xlang::impl
                 alternate->release();
             }
 
-            xlang_mem_free(this);
+            if (is_small_block())
+            {
+                free_small_string_block(this);
+            }
+            else
+            {
+                xlang_mem_free(this);
+            }
         }
         return result;
     }
@@ -233,14 +299,21 @@ namespace xlang::impl
         uint32_t length,
         cache_string* alternate)
     {
-        heap_string* new_string = reinterpret_cast<heap_string*>(xlang_mem_alloc(packed_buffer_size<heap_string, char_type>(length)));
+        // Preallocated buffers can shrink when promoted, so they always come from the heap.
+        uint32_t const size = packed_buffer_size<heap_string, char_type>(length);
+        bool const small_block = source_string && size <= small_string_block_size;
+        heap_string* new_string = reinterpret_cast<heap_string*>(small_block ? allocate_small_string_block() : xlang_mem_alloc(size));
         if (!new_string)
         {
             throw std::bad_alloc{};
         }
+        if (!small_block)
+        {
+            g_string_statistics.string_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
 
         char_type* buffer = get_packed_buffer_ptr<heap_string, char_type>(new_string);
-        new (new_string) heap_string(source_string, length, buffer);
+        new (new_string) heap_string(source_string, length, buffer, small_block ? string_flags::is_small_block : string_flags::none);
 
         if (alternate)
         {
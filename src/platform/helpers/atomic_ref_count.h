@@ -10,6 +10,8 @@ namespace xlang::impl
     {
         int32_t operator++() noexcept;
         int32_t operator--() noexcept;
+        int32_t operator+=(int32_t value) noexcept;
+        int32_t operator-=(int32_t value) noexcept;
 
         int32_t get_count() const noexcept;
 
@@ -45,6 +47,26 @@ namespace xlang::impl
         return result;
     }
 
+    inline int32_t atomic_ref_count::operator+=(int32_t value) noexcept
+    {
+        // Same reasoning as operator++, for callers handing out several references at once.
+        auto result = count.fetch_add(value, std::memory_order_relaxed) + value;
+        XLANG_ASSERT(result > value);
+        return result;
+    }
+
+    inline int32_t atomic_ref_count::operator-=(int32_t value) noexcept
+    {
+        // Same reasoning as operator--, for callers releasing several references at once.
+        auto result = count.fetch_sub(value, std::memory_order_release) - value;
+        XLANG_ASSERT(result >= 0);
+        if (result == 0)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return result;
+    }
+
     inline int32_t atomic_ref_count::get_count() const noexcept
     {
         return count.load(std::memory_order_acquire);
@@ -7,6 +7,10 @@ namespace xlang
 {
     [[noreturn]] inline void throw_result(xlang_result result, xlang_char8 const* const message = nullptr)
     {
+        if (!message)
+        {
+            throw xlang_originate_error(result);
+        }
         hstring error_message = to_hstring(message);
         throw xlang_originate_error(result, get_abi(error_message));
     }
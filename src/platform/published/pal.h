@@ -215,6 +215,19 @@ extern "C"
     };
 #endif
 
+    // Process-wide counters for the string storage and the conversions between UTF-8 and UTF-16 done by the PAL.
+    struct xlang_string_statistics
+    {
+        // Number of alternate encodings converted and cached on strings.
+        uint64_t alternate_conversions;
+        // Number of times a thread requested an alternate encoding while another thread was converting
+        // the same string, and waited for that result instead of converting it again.
+        uint64_t contended_conversions;
+        // Number of heap allocations made to hold string headers and character data. Empty and single
+        // ASCII character strings never allocate, and short strings reuse blocks cached per thread.
+        uint64_t string_allocations;
+    };
+
 #ifdef __cplusplus
     enum class xlang_result : uint32_t
     {
@@ -249,6 +262,20 @@ extern "C"
     };
 #endif
 
+#ifdef __cplusplus
+    enum class xlang_error_mode : uint32_t
+    {
+        full = 0,
+        lightweight = 1
+    };
+#else
+    enum xlang_error_mode
+    {
+        xlang_error_mode_full = 0,
+        xlang_error_mode_lightweight = 1
+    };
+#endif
+
     struct XLANG_NOVTABLE xlang_error_info : xlang_unknown
     {
         virtual void GetError(xlang_result* error) XLANG_NOEXCEPT = 0;
@@ -296,8 +323,40 @@ extern "C"
         xlang_string* string
     ) XLANG_NOEXCEPT;
 
+    // Creates a string and converts it up front into every encoding in encodings, which must include
+    // the encoding of source_string. Useful for strings known to be read in both encodings.
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_string_encoded_utf8(
+        xlang_char8 const* source_string,
+        uint32_t length,
+        xlang_string_encoding encodings,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_string_encoded_utf16(
+        char16_t const* source_string,
+        uint32_t length,
+        xlang_string_encoding encodings,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+
+    // Creates count strings in a single allocation shared by all of them. Each string is released
+    // independently, the allocation is freed once the last of them is released.
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_strings_utf8(
+        uint32_t count,
+        xlang_char8 const* const* source_strings,
+        uint32_t const* lengths,
+        xlang_string* strings
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_strings_utf16(
+        uint32_t count,
+        char16_t const* const* source_strings,
+        uint32_t const* lengths,
+        xlang_string* strings
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_string(xlang_string string) XLANG_NOEXCEPT;
 
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_strings(uint32_t count, xlang_string const* strings) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_delete_string_buffer(xlang_string_buffer buffer_handle) XLANG_NOEXCEPT;
 
     XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_duplicate_string(
@@ -309,6 +368,8 @@ extern "C"
         xlang_string string
     ) XLANG_NOEXCEPT;
 
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_get_string_statistics(xlang_string_statistics* statistics) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_string_raw_buffer_utf8(
         xlang_string string,
         xlang_char8 const* * buffer,
@@ -363,6 +424,11 @@ extern "C"
         xlang_unknown* language_information) XLANG_NOEXCEPT;
 #endif
 
+    // Controls how xlang_originate_error allocates error infos. In lightweight mode, errors with no
+    // message, language error, execution trace or language information share an immortal error info
+    // per xlang_result, and do not record propagation. Returns the previous mode.
+    XLANG_PAL_EXPORT xlang_error_mode XLANG_CALL xlang_set_error_mode(xlang_error_mode mode) XLANG_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "string_base.h"
+#include "atomic_ref_count.h"
+#include "cache_string.h"
+
+namespace xlang::impl
+{
+    struct string_slab;
+
+    struct slab_string : string_base
+    {
+        void addref() noexcept;
+        void release(int32_t release_count = 1) noexcept;
+
+        string_slab* get_slab() const noexcept;
+
+        // Read the ptr, but don't create it. May be null.
+        cache_string const* get_alternate() const noexcept;
+        cache_string* get_alternate() noexcept;
+
+    private:
+        friend string_slab;
+
+        template <typename char_type>
+        slab_string(
+            char_type const* source_string,
+            uint32_t length,
+            char_type* char_storage,
+            string_slab* slab
+        ) noexcept;
+
+        ~slab_string() = default;
+
+        slab_string() = delete;
+        slab_string(slab_string const&) = delete;
+        slab_string& operator=(slab_string const&) = delete;
+
+        string_slab* m_slab;
+    };
+
+    // A string_slab packs the headers and character data of a batch of strings into a single
+    // allocation. Every non-empty string in the batch holds a reference on the slab, and the
+    // allocation is freed once the last reference to any of its strings is released.
+    struct string_slab
+    {
+        template <typename char_type>
+        static void create(
+            uint32_t count,
+            char_type const* const* source_strings,
+            uint32_t const* lengths,
+            xlang_string* strings);
+
+        void addref() noexcept;
+        void release(int32_t release_count) noexcept;
+
+    private:
+        explicit string_slab(uint32_t string_count) noexcept
+            : m_string_count(string_count)
+        {}
+
+        ~string_slab() = default;
+
+        string_slab() = delete;
+        string_slab(string_slab const&) = delete;
+        string_slab& operator=(string_slab const&) = delete;
+
+        template <typename char_type>
+        static size_t entry_size(uint32_t length);
+
+        slab_string* first_string() noexcept;
+        static slab_string* next_string(slab_string* str) noexcept;
+
+        atomic_ref_count count;
+        uint32_t m_string_count;
+    };
+
+    template <typename char_type>
+    inline slab_string::slab_string(
+        char_type const* source_string,
+        uint32_t length,
+        char_type* char_storage,
+        string_slab* slab
+    ) noexcept
+        : string_base(char_storage, length, string_flags::is_slab)
+        , m_slab(slab)
+    {
+        static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>, "char_t must be either xlang_char8 or char16_t");
+        std::copy(source_string, source_string + length, char_storage);
+        char_storage[length] = 0;
+    }
+
+    inline void slab_string::addref() noexcept
+    {
+        m_slab->addref();
+    }
+
+    inline void slab_string::release(int32_t release_count) noexcept
+    {
+        m_slab->release(release_count);
+    }
+
+    inline string_slab* slab_string::get_slab() const noexcept
+    {
+        return m_slab;
+    }
+
+    inline cache_string const* slab_string::get_alternate() const noexcept
+    {
+        return this->get_alternate_ptr<cache_string>();
+    }
+
+    inline cache_string* slab_string::get_alternate() noexcept
+    {
+        return this->get_alternate_ptr<cache_string>();
+    }
+
+    template <typename char_type>
+    inline size_t string_slab::entry_size(uint32_t length)
+    {
+        // Each string header is followed by its null terminated character data, padded so the next
+        // header is suitably aligned.
+        size_t const size = packed_buffer_size<slab_string, char_type>(length);
+        constexpr size_t alignment = alignof(slab_string);
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    inline slab_string* string_slab::first_string() noexcept
+    {
+        static_assert(sizeof(string_slab) % alignof(slab_string) == 0);
+        return reinterpret_cast<slab_string*>(this + 1);
+    }
+
+    inline slab_string* string_slab::next_string(slab_string* str) noexcept
+    {
+        size_t const size = str->is_utf8() ?
+            entry_size<xlang_char8>(str->get_length()) :
+            entry_size<char16_t>(str->get_length());
+        return reinterpret_cast<slab_string*>(reinterpret_cast<uint8_t*>(str) + size);
+    }
+
+    template <typename char_type>
+    inline void string_slab::create(
+        uint32_t count,
+        char_type const* const* source_strings,
+        uint32_t const* lengths,
+        xlang_string* strings)
+    {
+        size_t total_size = sizeof(string_slab);
+        uint32_t string_count{};
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (!source_strings[i] && lengths[i] != 0)
+            {
+                throw_result(xlang_result::pointer);
+            }
+
+            if (lengths[i] != 0)
+            {
+                size_t const size = entry_size<char_type>(lengths[i]);
+                if (std::numeric_limits<size_t>::max() - total_size < size)
+                {
+                    throw_result(xlang_result::invalid_arg, "Insufficient buffer size");
+                }
+                total_size += size;
+                ++string_count;
+            }
+        }
+
+        if (string_count == 0)
+        {
+            std::fill(strings, strings + count, nullptr);
+            return;
+        }
+
+        if (string_count > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()))
+        {
+            throw_result(xlang_result::invalid_arg, "Too many strings");
+        }
+
+        string_slab* slab = reinterpret_cast<string_slab*>(xlang_mem_alloc(total_size));
+        if (!slab)
+        {
+            throw std::bad_alloc{};
+        }
+        g_string_statistics.string_allocations.fetch_add(1, std::memory_order_relaxed);
+
+        new (slab) string_slab(string_count);
+        if (string_count > 1)
+        {
+            slab->count += static_cast<int32_t>(string_count) - 1;
+        }
+
+        slab_string* current = slab->first_string();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (lengths[i] == 0)
+            {
+                strings[i] = nullptr;
+                continue;
+            }
+
+            char_type* buffer = get_packed_buffer_ptr<slab_string, char_type>(current);
+            new (current) slab_string(source_strings[i], lengths[i], buffer, slab);
+            strings[i] = reinterpret_cast<xlang_string>(static_cast<string_base*>(current));
+            current = next_string(current);
+        }
+    }
+
+    inline void string_slab::addref() noexcept
+    {
+        ++count;
+    }
+
+    inline void string_slab::release(int32_t release_count) noexcept
+    {
+        if ((count -= release_count) == 0)
+        {
+            slab_string* current = first_string();
+            for (uint32_t i = 0; i < m_string_count; ++i)
+            {
+                slab_string* next = next_string(current);
+                auto alternate = current->get_alternate();
+                if (alternate)
+                {
+                    alternate->release();
+                }
+                current->~slab_string();
+                current = next;
+            }
+
+            this->~string_slab();
+            xlang_mem_free(this);
+        }
+    }
+}
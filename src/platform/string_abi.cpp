@@ -1,5 +1,6 @@
 #include "opaque_string_wrapper.h"
 #include "string_reference.h"
+#include "slab_string.h"
 #include "pal_error.h"
 
 // Define the ABI-level implementations of string methods
@@ -37,6 +38,56 @@ namespace xlang::impl
         return nullptr;
     }
 
+    template <typename char_type>
+    xlang_string create_string_encoded(char_type const* source_string, uint32_t length, xlang_string_encoding encodings)
+    {
+        using alternate_char_type = alternate_string_type_t<char_type>;
+        constexpr xlang_string_encoding encoding = std::is_same_v<char_type, xlang_char8> ? xlang_string_encoding::utf8 : xlang_string_encoding::utf16;
+        constexpr xlang_string_encoding alternate_encoding = std::is_same_v<char_type, xlang_char8> ? xlang_string_encoding::utf16 : xlang_string_encoding::utf8;
+
+        if ((encodings & encoding) == xlang_string_encoding::none ||
+            (encodings | xlang_string_encoding::utf8 | xlang_string_encoding::utf16) != (xlang_string_encoding::utf8 | xlang_string_encoding::utf16))
+        {
+            xlang::throw_result(xlang_result::invalid_arg, "Encodings must include the encoding of the source string");
+        }
+
+        xlang_string result = create_string(source_string, length);
+        if (result && (encodings & alternate_encoding) != xlang_string_encoding::none)
+        {
+            try
+            {
+                from_handle(result)->ensure_buffer<alternate_char_type>();
+            }
+            catch (...)
+            {
+                from_handle(result)->release_base();
+                throw;
+            }
+        }
+        return result;
+    }
+
+    template <typename char_type>
+    void create_strings(
+        uint32_t count,
+        char_type const* const* source_strings,
+        uint32_t const* lengths,
+        xlang_string* strings
+    )
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (!source_strings || !lengths || !strings)
+        {
+            xlang::throw_result(xlang_result::pointer);
+        }
+
+        string_slab::create(count, source_strings, lengths, strings);
+    }
+
     template <typename char_type>
     xlang_string create_string_reference(
         char_type const* source_string,
@@ -172,6 +223,114 @@ XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_string(xlang_string string) XLANG_
     }
 }
 
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_string_encoded_utf8(
+    xlang_char8 const* source_string,
+    uint32_t length,
+    xlang_string_encoding encodings,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_encoded(source_string, length, encodings);
+    return nullptr;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_string_encoded_utf16(
+    char16_t const* source_string,
+    uint32_t length,
+    xlang_string_encoding encodings,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_encoded(source_string, length, encodings);
+    return nullptr;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_strings_utf8(
+    uint32_t count,
+    xlang_char8 const* const* source_strings,
+    uint32_t const* lengths,
+    xlang_string* strings
+) XLANG_NOEXCEPT
+try
+{
+    xlang::impl::create_strings(count, source_strings, lengths, strings);
+    return nullptr;
+}
+catch (...)
+{
+    if (strings)
+    {
+        std::fill(strings, strings + count, nullptr);
+    }
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_strings_utf16(
+    uint32_t count,
+    char16_t const* const* source_strings,
+    uint32_t const* lengths,
+    xlang_string* strings
+) XLANG_NOEXCEPT
+try
+{
+    xlang::impl::create_strings(count, source_strings, lengths, strings);
+    return nullptr;
+}
+catch (...)
+{
+    if (strings)
+    {
+        std::fill(strings, strings + count, nullptr);
+    }
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_strings(uint32_t count, xlang_string const* strings) XLANG_NOEXCEPT
+{
+    uint32_t i = 0;
+    while (i < count)
+    {
+        string_base* str = from_handle(strings[i++]);
+        if (!str)
+        {
+            continue;
+        }
+
+        if (!str->is_slab())
+        {
+            str->release_base();
+            continue;
+        }
+
+        // Release consecutive strings from the same slab with a single decrement.
+        string_slab* slab = static_cast<slab_string*>(str)->get_slab();
+        int32_t release_count = 1;
+        while (i < count && release_count < std::numeric_limits<int32_t>::max())
+        {
+            string_base* next = from_handle(strings[i]);
+            if (!next || !next->is_slab() || static_cast<slab_string*>(next)->get_slab() != slab)
+            {
+                break;
+            }
+            ++release_count;
+            ++i;
+        }
+        slab->release(release_count);
+    }
+}
+
 XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_delete_string_buffer(xlang_string_buffer buffer_handle) XLANG_NOEXCEPT
 try
 {
@@ -229,6 +388,13 @@ XLANG_PAL_EXPORT xlang_string_encoding XLANG_CALL xlang_get_string_encoding(
     }
 }
 
+XLANG_PAL_EXPORT void XLANG_CALL xlang_get_string_statistics(xlang_string_statistics* statistics) XLANG_NOEXCEPT
+{
+    statistics->alternate_conversions = g_string_statistics.alternate_conversions.load(std::memory_order_relaxed);
+    statistics->contended_conversions = g_string_statistics.contended_conversions.load(std::memory_order_relaxed);
+    statistics->string_allocations = g_string_statistics.string_allocations.load(std::memory_order_relaxed);
+}
+
 XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_string_raw_buffer_utf8(
     xlang_string string,
     xlang_char8 const* * buffer,
@@ -1,15 +1,167 @@
 #include "string_base.h"
 #include "string_reference.h"
 #include "heap_string.h"
+#include "slab_string.h"
+#include <thread>
 
 namespace xlang::impl
 {
+    string_statistics g_string_statistics;
+
+    namespace
+    {
+        // A bounded per-thread cache of small string blocks. Blocks beyond the limit go back to the heap.
+        // The cache is trivially constructible so that reaching it is a plain thread_local access. Its
+        // cleanup is registered the first time the thread caches a block.
+        struct small_string_block_cache
+        {
+            static constexpr uint32_t max_count = 64;
+
+            enum class cache_state : uint32_t
+            {
+                unused,
+                active,
+                destroyed, // Blocks released after the thread's cleanup go straight back to the heap.
+            };
+
+            struct node
+            {
+                node* next;
+            };
+
+            node* head;
+            uint32_t count;
+            cache_state state;
+        };
+
+        thread_local small_string_block_cache t_small_string_cache{};
+
+        struct small_string_block_cache_cleanup
+        {
+            ~small_string_block_cache_cleanup() noexcept
+            {
+                auto& cache = t_small_string_cache;
+                cache.state = small_string_block_cache::cache_state::destroyed;
+                while (cache.head)
+                {
+                    auto next = cache.head->next;
+                    xlang_mem_free(cache.head);
+                    cache.head = next;
+                }
+                cache.count = 0;
+            }
+        };
+    }
+
+    void* allocate_small_string_block() noexcept
+    {
+        auto& cache = t_small_string_cache;
+        if (cache.head)
+        {
+            auto block = cache.head;
+            cache.head = block->next;
+            --cache.count;
+            return block;
+        }
+
+        void* block = xlang_mem_alloc(small_string_block_size);
+        if (block)
+        {
+            g_string_statistics.string_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        return block;
+    }
+
+    void free_small_string_block(void* block) noexcept
+    {
+        auto& cache = t_small_string_cache;
+        if (cache.state == small_string_block_cache::cache_state::unused)
+        {
+            thread_local small_string_block_cache_cleanup cleanup;
+            static_cast<void>(cleanup);
+            cache.state = small_string_block_cache::cache_state::active;
+        }
+
+        if (cache.state != small_string_block_cache::cache_state::active || cache.count == small_string_block_cache::max_count)
+        {
+            xlang_mem_free(block);
+            return;
+        }
+
+        cache.head = new (block) small_string_block_cache::node{ cache.head };
+        ++cache.count;
+    }
+
+    cache_string* string_base::create_alternate()
+    {
+        while (true)
+        {
+            void* expected = nullptr;
+            if (alternate_form.compare_exchange_strong(expected, reinterpret_cast<void*>(alternate_converting), std::memory_order_acquire))
+            {
+                // This thread owns the conversion. On failure, reset the state so a waiting thread can
+                // retry and observe the error itself.
+                std::unique_ptr<cache_string, xlang_mem_deleter> new_alternate;
+                try
+                {
+                    new_alternate = is_utf8() ?
+                        cache_string::create(get_buffer<xlang_char8>(), get_length()) :
+                        cache_string::create(get_buffer<char16_t>(), get_length());
+                }
+                catch (...)
+                {
+                    alternate_form.store(nullptr, std::memory_order_release);
+                    throw;
+                }
+
+                g_string_statistics.alternate_conversions.fetch_add(1, std::memory_order_relaxed);
+                alternate_form.store(new_alternate.get(), std::memory_order_release);
+                return new_alternate.release();
+            }
+
+            if (!is_alternate_converting(expected))
+            {
+                return reinterpret_cast<cache_string*>(expected);
+            }
+
+            g_string_statistics.contended_conversions.fetch_add(1, std::memory_order_relaxed);
+            cache_string* alternate = wait_for_alternate();
+            if (alternate)
+            {
+                return alternate;
+            }
+        }
+    }
+
+    cache_string* string_base::wait_for_alternate() noexcept
+    {
+        // Conversions are short, so spin briefly before yielding the rest of each time slice.
+        // Returns null if the converting thread failed.
+        for (uint32_t attempt = 0; ; ++attempt)
+        {
+            void* const value = alternate_form.load(std::memory_order_acquire);
+            if (!is_alternate_converting(value))
+            {
+                return reinterpret_cast<cache_string*>(value);
+            }
+
+            if (attempt >= 64)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
     void string_base::release_base() noexcept
     {
         if (this->is_reference())
         {
             static_cast<string_reference*>(this)->release();
         }
+        else if (this->is_slab())
+        {
+            static_cast<slab_string*>(this)->release();
+        }
         else
         {
             static_cast<heap_string*>(this)->release();
@@ -31,6 +183,11 @@ namespace xlang::impl
                 return heap_string::create(str->get_buffer<char16_t>(), str->get_length(), str->get_alternate());
             }
         }
+        else if (this->is_slab())
+        {
+            static_cast<slab_string*>(this)->addref();
+            return this;
+        }
         else
         {
             static_cast<heap_string*>(this)->addref();
@@ -14,6 +14,9 @@ namespace xlang::impl
     {
         none = 0x0000,         // None
         is_reference = 0x0001, // Whether this is a "fast" string
+        is_slab = 0x0002,      // Shares its allocation and reference count with other strings in a slab
+        is_immortal = 0x0004,  // Statically allocated, never freed, and ignores reference counting
+        is_small_block = 0x0008, // Allocated from the per-thread small string block cache
         is_utf8 = 0x0020,      // Character pointer is UTF-8 data
 
         is_preallocated_string_buffer = 0xF8B10000,
@@ -55,6 +58,9 @@ namespace xlang::impl
 
     inline constexpr string_flags all_valid_flags =
         string_flags::is_reference |
+        string_flags::is_slab |
+        string_flags::is_immortal |
+        string_flags::is_small_block |
         string_flags::is_utf8 |
         string_flags::reserved_for_preallocated_string_buffer;
 
@@ -95,7 +101,12 @@ namespace xlang::impl
     //          a buffer provided by the caller.
     //
     //      heap_string is a shared, immutable, heap-allocated string instance that packes the
-    //          string header data and character data into a single allocation.
+    //          string header data and character data into a single allocation. Short strings take
+    //          their allocation from a per-thread cache of fixed-size blocks, and single ASCII
+    //          character strings are immortal instances shared by the whole process.
+    //
+    //      slab_string is a shared, immutable string created in a batch. All strings of a batch
+    //          share a single allocation and reference count, owned by a string_slab.
     //
     // cache_string holds is *NOT* a sub-class of string_base.
     //     It holds string buffer data when a raw buffer is requested in a different
@@ -115,6 +126,9 @@ namespace xlang::impl
         char_type const* get_buffer() const noexcept;
 
         bool is_reference() const noexcept;
+        bool is_slab() const noexcept;
+        bool is_immortal() const noexcept;
+        bool is_small_block() const noexcept;
         bool is_preallocated_buffer() const noexcept;
         bool is_utf8() const noexcept;
         bool has_alternate() const noexcept;
@@ -146,8 +160,32 @@ namespace xlang::impl
     private:
         template <typename my_char_type, typename requested_char_type>
         std::basic_string_view<requested_char_type> ensure_buffer_impl();
+
+        // Converts and publishes the alternate form, or waits for the thread already converting it.
+        cache_string* create_alternate();
+        cache_string* wait_for_alternate() noexcept;
+    };
+
+    // While a thread converts a string, alternate_form holds this value so that other threads wait
+    // for the result instead of converting the same string in parallel.
+    inline constexpr uintptr_t alternate_converting = 1;
+
+    inline bool is_alternate_converting(void const* value) noexcept
+    {
+        return reinterpret_cast<uintptr_t>(value) == alternate_converting;
+    }
+
+    // Process-wide counters for string storage and alternate form conversions, reported by
+    // xlang_get_string_statistics.
+    struct string_statistics
+    {
+        std::atomic<uint64_t> alternate_conversions{};
+        std::atomic<uint64_t> contended_conversions{};
+        std::atomic<uint64_t> string_allocations{};
     };
 
+    extern string_statistics g_string_statistics;
+
     // This class is a wrapper, need to be able to up-cast safely, which means layout can't change.
     static_assert(sizeof(string_base) == sizeof(string_storage_base), "Class layout must match");
 
@@ -167,6 +205,21 @@ namespace xlang::impl
         return (flags & string_flags::is_reference) != string_flags::none;
     }
 
+    inline bool string_base::is_slab() const noexcept
+    {
+        return (flags & string_flags::is_slab) != string_flags::none;
+    }
+
+    inline bool string_base::is_immortal() const noexcept
+    {
+        return (flags & string_flags::is_immortal) != string_flags::none;
+    }
+
+    inline bool string_base::is_small_block() const noexcept
+    {
+        return (flags & string_flags::is_small_block) != string_flags::none;
+    }
+
     inline bool string_base::is_preallocated_buffer() const noexcept
     {
         return (flags & string_flags::reserved_for_preallocated_string_buffer) == string_flags::is_preallocated_string_buffer;
@@ -207,13 +260,15 @@ namespace xlang::impl
     template <typename alternate_type>
     inline alternate_type const* string_base::get_alternate_ptr() const noexcept
     {
-        return reinterpret_cast<alternate_type const*>(this->alternate_form.load());
+        void* const value = this->alternate_form.load(std::memory_order_acquire);
+        return is_alternate_converting(value) ? nullptr : reinterpret_cast<alternate_type const*>(value);
     }
 
     template <typename alternate_type>
     inline alternate_type* string_base::get_alternate_ptr() noexcept
     {
-        return reinterpret_cast<alternate_type*>(this->alternate_form.load());
+        void* const value = this->alternate_form.load(std::memory_order_acquire);
+        return is_alternate_converting(value) ? nullptr : reinterpret_cast<alternate_type*>(value);
     }
 
     template <typename alternate_type>
@@ -255,13 +310,7 @@ namespace xlang::impl
             cache_string* alternate = get_alternate_ptr<cache_string>();
             if (!alternate)
             {
-                auto new_alternate = cache_string::create(get_buffer<my_char_type>(), get_length());
-                alternate = set_alternate_ptr<cache_string>(new_alternate.get());
-                if (alternate == new_alternate.get())
-                {
-                    // We won the race. Can safely handoff lifetime management to string_base
-                    new_alternate.release();
-                }
+                alternate = create_alternate();
             }
             return { alternate->get_buffer<requested_char_type>(), alternate->get_length() };
         }
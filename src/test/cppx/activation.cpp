@@ -0,0 +1,95 @@
+#include "pch.h"
+
+using namespace xlang;
+
+namespace
+{
+    struct missing_class
+    {
+    };
+
+    // Implemented by the AbiComponent test module, which must be next to the test.
+    struct widget_class
+    {
+    };
+
+    template <typename Class>
+    std::optional<factory_cache_statistics> find_statistics()
+    {
+        for (auto&& value : get_factory_cache_statistics())
+        {
+            if (value.class_name == name_of<Class>())
+            {
+                return value;
+            }
+        }
+
+        return {};
+    }
+}
+
+namespace xlang::impl
+{
+    template <> struct name<missing_class>
+    {
+        static constexpr auto& value{ u8"Test.Missing.Class" };
+    };
+
+    template <> struct name<widget_class>
+    {
+        static constexpr auto& value{ u8"AbiComponent.Widget" };
+    };
+}
+
+TEST_CASE("activation,factory cache")
+{
+    REQUIRE(!find_statistics<missing_class>());
+    REQUIRE_THROWS_AS(get_activation_factory<missing_class>(), xlang_error);
+
+    // Failed resolutions are never cached, so each attempt is a miss.
+    REQUIRE_THROWS_AS(preload_factories<missing_class>(), xlang_error);
+    preload_factories<>();
+
+    auto const statistics = find_statistics<missing_class>();
+    REQUIRE(statistics);
+    REQUIRE(statistics->interface_id == guid_of<Windows::Foundation::IActivationFactory>());
+    REQUIRE(statistics->misses == 2);
+    REQUIRE(statistics->hits == 0);
+
+    REQUIRE_THROWS_AS(preload_factories({ hstring{ u8"Test.Missing.Class" }, hstring{ u8"Test.Missing.Other" } }), xlang_error);
+    clear_factory_caches();
+}
+
+TEST_CASE("activation,factory cache,hit")
+{
+    using Windows::Foundation::IUnknown;
+    count_factory_cache_hits(true);
+
+    auto const first = get_activation_factory<widget_class, IUnknown>();
+    auto const second = get_activation_factory<widget_class, IUnknown>();
+    REQUIRE(first);
+    REQUIRE(first == second);
+
+    auto statistics = find_statistics<widget_class>();
+    REQUIRE(statistics);
+    REQUIRE(statistics->interface_id == guid_of<IUnknown>());
+    REQUIRE(statistics->misses == 1);
+    REQUIRE(statistics->hits == 1);
+
+    // The module hands out a new factory each time, so a cleared cache resolves a different one.
+    clear_factory_caches();
+    auto const third = get_activation_factory<widget_class, IUnknown>();
+    REQUIRE(third);
+    REQUIRE(third != first);
+
+    statistics = find_statistics<widget_class>();
+    REQUIRE(statistics->misses == 2);
+    REQUIRE(statistics->hits == 1);
+
+    // Hits aren't counted once counting is turned off.
+    count_factory_cache_hits(false);
+    get_activation_factory<widget_class, IUnknown>();
+    REQUIRE(find_statistics<widget_class>()->hits == 1);
+
+    clear_factory_caches();
+}
@@ -0,0 +1,72 @@
+#include "pch.h"
+
+using namespace xlang;
+
+TEST_CASE("com_array,from vector")
+{
+    std::vector<float, mem_allocator<float>> adopted{ 1.0f, 2.0f, 3.0f };
+    float const* const buffer = adopted.data();
+    com_array<float> first(std::move(adopted));
+    REQUIRE(first.data() == buffer);
+    REQUIRE(std::vector<float>(first.begin(), first.end()) == std::vector<float>{ 1.0f, 2.0f, 3.0f });
+
+    // Other allocators can't free the ABI's arrays, so their elements are moved instead.
+    std::vector<hstring> moved{ hstring{ u8"one" }, hstring{ u8"two" } };
+    com_array<hstring> second(std::move(moved));
+    REQUIRE(second.size() == 2);
+    REQUIRE(second[1] == u8"two");
+
+    std::vector<hstring, mem_allocator<hstring>> empty;
+    empty.reserve(4);
+    REQUIRE(com_array<hstring>(std::move(empty)).empty());
+}
+
+TEST_CASE("com_array,from unique_ptr")
+{
+    std::unique_ptr<uint8_t[], mem_deleter> adopted{ static_cast<uint8_t*>(xlang_mem_alloc(4)) };
+    std::fill_n(adopted.get(), 4, uint8_t{ 7 });
+    uint8_t const* const buffer = adopted.get();
+    com_array<uint8_t> first(std::move(adopted), 4);
+    REQUIRE(first.data() == buffer);
+    REQUIRE(first.size() == 4);
+    REQUIRE(!adopted);
+
+    std::unique_ptr<uint8_t[]> copied{ new uint8_t[2]{ 1, 2 } };
+    com_array<uint8_t> second(std::move(copied), 2);
+    REQUIRE(std::vector<uint8_t>(second.begin(), second.end()) == std::vector<uint8_t>{ 1, 2 });
+    REQUIRE(!copied);
+}
+
+TEST_CASE("com_array,adopt_vector")
+{
+    com_array<hstring> array{ hstring{ u8"one" }, hstring{ u8"two" }, hstring{ u8"three" } };
+    hstring const* const buffer = array.data();
+
+    auto values = adopt_vector(std::move(array));
+    REQUIRE(array.empty());
+    REQUIRE(values.data() == buffer);
+    REQUIRE(values.size() == 3);
+    REQUIRE(values[2] == u8"three");
+
+    // The vector grows through the PAL heap and the elements go back across the ABI the same way.
+    values.push_back(hstring{ u8"four" });
+    com_array<hstring> returned(std::move(values));
+    REQUIRE(returned.size() == 4);
+    REQUIRE(returned[3] == u8"four");
+
+    REQUIRE(adopt_vector(com_array<int32_t>{}).empty());
+}
+
+TEST_CASE("com_array,mem_allocator")
+{
+    auto buffer = static_cast<int32_t*>(xlang_mem_alloc(sizeof(int32_t)));
+    mem_allocator<int32_t> adopting(buffer, 1);
+    REQUIRE(adopting != mem_allocator<int32_t>{});
+
+    // A first allocation of another size gets a new buffer and the adopted one is dropped.
+    int32_t* const other = adopting.allocate(2);
+    REQUIRE(other != buffer);
+    REQUIRE(adopting == mem_allocator<int64_t>{});
+    adopting.deallocate(other, 2);
+    xlang_mem_free(buffer);
+}
@@ -181,4 +181,3 @@ TEST_CASE("simple_containers")
     test_associative(make<simple_map_view>(), associative);
     test_associative(make<simple_map>(), associative);
 }
-
@@ -0,0 +1,184 @@
+#include "pch.h"
+
+// The collection interfaces are projected from the Foundation metadata, which is only compiled where
+// ilasm is available. Elsewhere this file builds but has nothing to test.
+#if __has_include(<xlang/Foundation.Collections.h>)
+
+#include <xlang/Foundation.Collections.h>
+#include <atomic>
+#include <thread>
+
+using namespace xlang;
+using namespace Foundation::Collections;
+
+TEST_CASE("bulk_range,sequence")
+{
+    std::vector<int> const expected{ 1,2,3 };
+
+    auto test_bulk = [&](auto const& collection, uint32_t block_size)
+    {
+        std::vector<int> actual;
+
+        for (int value : bulk_range(collection, block_size))
+        {
+            actual.push_back(value);
+        }
+
+        REQUIRE(actual == expected);
+    };
+
+    for (uint32_t block_size : { 1u, 2u, 64u })
+    {
+        IVector<int> values = single_threaded_vector<int>({ 1,2,3 });
+        test_bulk(values, block_size);
+        test_bulk(values.GetView(), block_size);
+        test_bulk(values.as<IIterable<int>>(), block_size);
+    }
+}
+
+TEST_CASE("bulk_range,temporary")
+{
+    // The range keeps its own reference, so a collection returned by value outlives the loop.
+    std::vector<int> actual;
+
+    for (int value : bulk_range(single_threaded_vector<int>({ 1,2,3 }), 2))
+    {
+        actual.push_back(value);
+    }
+
+    REQUIRE(actual == std::vector<int>{ 1,2,3 });
+}
+
+TEST_CASE("bulk_range,shrinking")
+{
+    // As with a range-based for loop, shrinking the vector fails once iteration reaches the
+    // elements that were removed.
+    IVector<int> values = single_threaded_vector<int>({ 1,2,3 });
+    uint32_t count{};
+
+    REQUIRE_THROWS_AS([&]
+    {
+        for (int value : bulk_range(values, 1))
+        {
+            static_cast<void>(value);
+
+            if (++count == 1)
+            {
+                values.RemoveAtEnd();
+            }
+        }
+    }(), out_of_bounds_error);
+
+    REQUIRE(count == 2);
+}
+
+TEST_CASE("single_threaded_hash_map")
+{
+    IMap<hstring, int> values = single_threaded_hash_map<hstring, int>();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        REQUIRE(!values.Insert(hstring(std::to_string(i).c_str()), i));
+    }
+
+    REQUIRE(values.Insert(u8"42", 420));
+    REQUIRE(values.Size() == 100);
+    REQUIRE(values.Lookup(u8"42") == 420);
+    REQUIRE(values.HasKey(u8"99"));
+    REQUIRE_THROWS_AS(values.Lookup(u8"100"), out_of_bounds_error);
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        values.Remove(hstring(std::to_string(i).c_str()));
+    }
+
+    REQUIRE(values.Size() == 50);
+    REQUIRE(!values.HasKey(u8"42"));
+    REQUIRE(values.Lookup(u8"43") == 43);
+
+    int sum{};
+
+    for (auto&& pair : values)
+    {
+        sum += pair.Value();
+    }
+
+    REQUIRE(sum == 2500);
+
+    auto first = values.First();
+    values.Insert(u8"100", 100);
+    REQUIRE_THROWS_AS(first.Current(), invalid_state_error);
+}
+
+TEST_CASE("multi_threaded collections")
+{
+    IVector<int> vector = multi_threaded_vector<int>();
+    IMap<int, int> map = multi_threaded_map<int, int>();
+    std::vector<std::thread> threads;
+
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([=]
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                vector.Append(i);
+                map.Insert(thread * 1000 + i, i);
+                static_cast<void>(vector.GetAt(vector.Size() - 1));
+                static_cast<void>(map.HasKey(i));
+            }
+        });
+    }
+
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(vector.Size() == 4000);
+    REQUIRE(map.Size() == 4000);
+    REQUIRE(map.Lookup(3999) == 999);
+
+    auto first = vector.First();
+    vector.Append(0);
+    REQUIRE_THROWS_AS(first.MoveNext(), invalid_state_error);
+}
+
+TEST_CASE("multi_threaded collections,concurrent iteration")
+{
+    // Iterators are created and read while another thread keeps growing the vector. Each iterator
+    // either walks a consistent snapshot or fails once the vector has changed.
+    IVector<int> vector = multi_threaded_vector<int>();
+    std::atomic<bool> done{};
+
+    std::thread writer([&]
+    {
+        for (int i = 0; i < 10000; ++i)
+        {
+            vector.Append(i);
+        }
+
+        done = true;
+    });
+
+    while (!done)
+    {
+        try
+        {
+            int expected{};
+
+            for (auto current = vector.First(); current.HasCurrent(); current.MoveNext())
+            {
+                REQUIRE(current.Current() == expected++);
+            }
+        }
+        catch (invalid_state_error const&)
+        {
+        }
+    }
+
+    writer.join();
+    REQUIRE(vector.Size() == 10000);
+}
+
+#endif
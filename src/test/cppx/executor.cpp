@@ -0,0 +1,472 @@
+#include "pch.h"
+
+#include <xlang/executor.h>
+#include <functional>
+#include <thread>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace xlang;
+using namespace std::chrono_literals;
+
+namespace
+{
+    struct countdown
+    {
+        explicit countdown(uint32_t count) noexcept : m_count(count)
+        {
+        }
+
+        void signal()
+        {
+            std::lock_guard const guard(m_lock);
+
+            if (--m_count == 0)
+            {
+                m_done.notify_all();
+            }
+        }
+
+        bool wait(std::chrono::seconds timeout = 10s)
+        {
+            std::unique_lock guard(m_lock);
+            return m_done.wait_for(guard, timeout, [&] { return m_count == 0; });
+        }
+
+    private:
+
+        std::mutex m_lock;
+        std::condition_variable m_done;
+        uint32_t m_count;
+    };
+}
+
+TEST_CASE("executor,post")
+{
+    executor pool{ 4 };
+    REQUIRE(pool.thread_count() == 4);
+    REQUIRE(executor::current() == nullptr);
+
+    constexpr uint32_t count = 10000;
+    std::atomic<uint32_t> completed{};
+    std::atomic<uint32_t> on_pool{};
+    countdown done{ count };
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        pool.post([&]
+        {
+            if (executor::current() == &pool)
+            {
+                ++on_pool;
+            }
+
+            ++completed;
+            done.signal();
+        });
+    }
+
+    REQUIRE(done.wait());
+    REQUIRE(completed == count);
+    REQUIRE(on_pool == count);
+}
+
+TEST_CASE("executor,post,nested")
+{
+    executor pool{ 2 };
+    constexpr uint32_t count = 1000;
+    countdown done{ count };
+
+    pool.post([&]
+    {
+        // Work posted from a worker is queued on that worker and may be stolen by the others.
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pool.post([&] { done.signal(); });
+        }
+    });
+
+    REQUIRE(done.wait());
+}
+
+TEST_CASE("executor,destructor,drains")
+{
+    std::atomic<uint32_t> completed{};
+
+    {
+        executor pool{ 1 };
+        pool.post([] { std::this_thread::sleep_for(10ms); });
+
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            pool.post([&] { ++completed; });
+        }
+    }
+
+    REQUIRE(completed == 100);
+}
+
+TEST_CASE("executor,post_after")
+{
+    executor pool{ 2 };
+    std::mutex lock;
+    std::vector<int> order;
+    countdown done{ 3 };
+    auto const start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration elapsed{};
+
+    auto record = [&](int value)
+    {
+        return [&, value]
+        {
+            std::lock_guard const guard(lock);
+            order.push_back(value);
+            elapsed = std::chrono::steady_clock::now() - start;
+            done.signal();
+        };
+    };
+
+    pool.post_after(60ms, record(3));
+    pool.post_after(20ms, record(1));
+    pool.post_after(40ms, record(2));
+
+    REQUIRE(done.wait());
+    REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+    REQUIRE(elapsed >= 60ms);
+}
+
+TEST_CASE("executor,post_after,beyond rotation")
+{
+    // Longer than one turn of the timer wheel.
+    executor pool{ 1 };
+    countdown done{ 2 };
+    auto const start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration elapsed{};
+
+    pool.post_after(300ms, [&] { elapsed = std::chrono::steady_clock::now() - start; done.signal(); });
+    pool.post_after(0ms, [&] { done.signal(); });
+
+    REQUIRE(done.wait());
+    REQUIRE(elapsed >= 300ms);
+}
+
+#ifdef __linux__
+TEST_CASE("executor,post_on_ready")
+{
+    executor pool{ 2 };
+    int fds[2]{};
+    REQUIRE(pipe(fds) == 0);
+
+    struct state
+    {
+        countdown done{ 1 };
+        uint32_t events{};
+        executor* current{};
+    } result;
+
+    pool.post_on_ready(fds[0], EPOLLIN, [](void* context, uint32_t events)
+    {
+        auto result = static_cast<state*>(context);
+        result->events = events;
+        result->current = executor::current();
+        result->done.signal();
+    }, &result);
+
+    char const value = 'x';
+    REQUIRE(write(fds[1], &value, 1) == 1);
+    REQUIRE(result.done.wait());
+    REQUIRE((result.events & EPOLLIN) != 0);
+    REQUIRE(result.current == &pool);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
+
+#if defined(_RESUMABLE_FUNCTIONS_SUPPORTED) || defined(__cpp_coroutines)
+namespace
+{
+    // Starts running on the calling thread and destroys itself when it completes.
+    struct task
+    {
+        struct promise_type
+        {
+            task get_return_object() const noexcept
+            {
+                return {};
+            }
+
+            std::experimental::suspend_never initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::experimental::suspend_never final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept
+            {
+            }
+
+            void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    struct hop
+    {
+        executor* current;
+        std::thread::id thread;
+    };
+
+    struct journal
+    {
+        void record()
+        {
+            std::lock_guard const guard(m_lock);
+            m_hops.push_back({ executor::current(), std::this_thread::get_id() });
+        }
+
+        std::vector<hop> hops()
+        {
+            std::lock_guard const guard(m_lock);
+            return m_hops;
+        }
+
+    private:
+
+        std::mutex m_lock;
+        std::vector<hop> m_hops;
+    };
+}
+
+TEST_CASE("executor,resume_on")
+{
+    executor first{ 1 };
+    executor second{ 1 };
+    journal steps;
+    countdown done{ 1 };
+
+    [&]() -> task
+    {
+        steps.record();
+        co_await resume_on(first);
+        steps.record();
+        co_await resume_on(second);
+        steps.record();
+        done.signal();
+    }();
+
+    REQUIRE(done.wait());
+    auto const hops = steps.hops();
+    REQUIRE(hops.size() == 3);
+    REQUIRE(hops[0].current == nullptr);
+    REQUIRE(hops[0].thread == std::this_thread::get_id());
+    REQUIRE(hops[1].current == &first);
+    REQUIRE(hops[1].thread != std::this_thread::get_id());
+    REQUIRE(hops[2].current == &second);
+    REQUIRE(hops[2].thread != hops[1].thread);
+}
+
+TEST_CASE("executor,resume_after")
+{
+    executor pool{ 2 };
+    std::mutex lock;
+    std::vector<std::pair<int, executor*>> order;
+    countdown done{ 3 };
+    auto const start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration elapsed{};
+
+    auto sleeper = [&](int value, Foundation::TimeSpan duration) -> task
+    {
+        co_await resume_after(pool, duration);
+        std::lock_guard const guard(lock);
+        order.emplace_back(value, executor::current());
+        elapsed = std::chrono::steady_clock::now() - start;
+        done.signal();
+    };
+
+    sleeper(3, 60ms);
+    sleeper(1, 20ms);
+    sleeper(2, 40ms);
+
+    REQUIRE(done.wait());
+    REQUIRE(order == std::vector<std::pair<int, executor*>>{ { 1, &pool }, { 2, &pool }, { 3, &pool } });
+    REQUIRE(elapsed >= 60ms);
+
+    // A zero duration is ready at once and carries on without leaving the calling thread.
+    bool resumed{};
+
+    [&]() -> task
+    {
+        co_await resume_after(pool, Foundation::TimeSpan{});
+        resumed = executor::current() == nullptr;
+    }();
+
+    REQUIRE(resumed);
+}
+
+#ifdef __linux__
+TEST_CASE("executor,resume_on_ready")
+{
+    executor pool{ 2 };
+    int fds[2]{};
+    REQUIRE(pipe(fds) == 0);
+
+    std::atomic<bool> resumed{};
+    uint32_t events{};
+    executor* current{};
+    countdown done{ 1 };
+
+    [&]() -> task
+    {
+        events = co_await resume_on_ready(pool, fds[0], EPOLLIN);
+        current = executor::current();
+        resumed = true;
+        done.signal();
+    }();
+
+    // Nothing has been written, so the coroutine must still be suspended.
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(!resumed);
+
+    char const value = 'x';
+    REQUIRE(write(fds[1], &value, 1) == 1);
+    REQUIRE(done.wait());
+    REQUIRE((events & EPOLLIN) != 0);
+    REQUIRE(current == &pool);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
+
+#ifndef _WIN32
+namespace
+{
+    // Stands in for an async interface. It completes on a thread that belongs to no executor, once the
+    // awaiting coroutine has registered its handler.
+    struct fake_async
+    {
+        void Completed(std::function<void(fake_async const&, int)> handler) const
+        {
+            std::lock_guard const guard(m_lock);
+            m_handler = std::move(handler);
+            m_registered.notify_all();
+        }
+
+        void complete() const
+        {
+            std::thread([this]
+            {
+                std::unique_lock guard(m_lock);
+                m_registered.wait(guard, [&] { return static_cast<bool>(m_handler); });
+                auto handler = std::move(m_handler);
+                guard.unlock();
+                handler(*this, 1);
+            }).join();
+        }
+
+    private:
+
+        mutable std::mutex m_lock;
+        mutable std::condition_variable m_registered;
+        mutable std::function<void(fake_async const&, int)> m_handler;
+    };
+
+    // The non-Windows half of impl::await_adapter, which needs the Foundation projection for the rest.
+    struct fake_await_adapter
+    {
+        fake_async const& async;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::experimental::coroutine_handle<> handle) const
+        {
+            impl::resume_on_completed(async, handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+}
+
+TEST_CASE("executor,resume_background")
+{
+    journal steps;
+    countdown done{ 1 };
+
+    [&]() -> task
+    {
+        co_await resume_background();
+        steps.record();
+        co_await Foundation::TimeSpan{ 20ms };
+        steps.record();
+        co_await resume_after(Foundation::TimeSpan{ 20ms });
+        steps.record();
+        done.signal();
+    }();
+
+    REQUIRE(done.wait());
+    auto const hops = steps.hops();
+    REQUIRE(hops.size() == 3);
+
+    for (auto&& hop : hops)
+    {
+        REQUIRE(hop.current == &executor::background());
+        REQUIRE(hop.thread != std::this_thread::get_id());
+    }
+}
+
+TEST_CASE("executor,await_adapter")
+{
+    executor pool{ 1 };
+    fake_async async;
+    journal steps;
+    countdown done{ 2 };
+
+    // A coroutine running on an executor resumes there rather than on the completing thread.
+    [&]() -> task
+    {
+        co_await resume_on(pool);
+        steps.record();
+        co_await fake_await_adapter{ async };
+        steps.record();
+        done.signal();
+    }();
+
+    async.complete();
+
+    // A coroutine that isn't running on an executor resumes on the background executor.
+    fake_async other;
+    executor* other_current{};
+
+    [&]() -> task
+    {
+        co_await fake_await_adapter{ other };
+        other_current = executor::current();
+        done.signal();
+    }();
+
+    other.complete();
+
+    REQUIRE(done.wait());
+    auto const hops = steps.hops();
+    REQUIRE(hops.size() == 2);
+    REQUIRE(hops[0].current == &pool);
+    REQUIRE(hops[1].current == &pool);
+    REQUIRE(hops[1].thread == hops[0].thread);
+    REQUIRE(other_current == &executor::background());
+}
+#endif
+#endif
@@ -581,3 +581,60 @@ static bool compare_hash(const u8string & value)
     return std::hash<u8string>{}(value) == std::hash<hstring>{}(hstring(value));
 }
 
+
+namespace
+{
+    template <typename T>
+    void test_to_hstring(T const value, char const* format)
+    {
+        char expected[64];
+        snprintf(expected, std::size(expected), format, value);
+        REQUIRE(to_hstring(value) == hstring{ std::string_view{ expected } });
+    }
+
+    template <typename T>
+    void test_integer_to_hstring(char const* format)
+    {
+        for (T const value : { std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), T{}, T{ 1 }, T{ 9 }, T{ 10 }, T{ 99 }, T{ 100 }, static_cast<T>(-1), static_cast<T>(-10) })
+        {
+            test_to_hstring(value, format);
+        }
+    }
+}
+
+TEST_CASE("hstring,to_hstring,number")
+{
+    test_integer_to_hstring<uint8_t>("%" PRIu8);
+    test_integer_to_hstring<int8_t>("%" PRId8);
+    test_integer_to_hstring<uint16_t>("%" PRIu16);
+    test_integer_to_hstring<int16_t>("%" PRId16);
+    test_integer_to_hstring<uint32_t>("%" PRIu32);
+    test_integer_to_hstring<int32_t>("%" PRId32);
+    test_integer_to_hstring<uint64_t>("%" PRIu64);
+    test_integer_to_hstring<int64_t>("%" PRId64);
+
+    for (double const value : { 0.0, -0.0, 1.0, -1.5, 0.1, 123456.0, 1234567.0, 1e-5, 1e-4, 1e100, -1.7976931348623157e308, 4.9e-324,
+        std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() })
+    {
+        test_to_hstring(value, "%G");
+        test_to_hstring(static_cast<float>(value), "%G");
+    }
+}
+
+TEST_CASE("hstring,to_hstring,guid")
+{
+    guid const value{ 0x01234567, 0x89ab, 0xcdef, { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0xff } };
+    REQUIRE(to_hstring(value) == u8"{01234567-89ab-cdef-0011-2233445566ff}");
+    REQUIRE(to_hstring(guid{}) == u8"{00000000-0000-0000-0000-000000000000}");
+}
+
+TEST_CASE("hstring,format_hstring")
+{
+    guid const value{ 0x01234567, 0x89ab, 0xcdef, { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0xff } };
+
+    REQUIRE(format_hstring().empty());
+    REQUIRE(format_hstring(u8"").empty());
+    REQUIRE(format_hstring(hstring{ u8"abc" }, 42, u8" ", -7, u8" ", true, u8" ", 1.5) == u8"abc42 -7 true 1.5");
+    REQUIRE(format_hstring(u8"id=", uint8_t{ 255 }, u8" iid=", value) == u8"id=255 iid={01234567-89ab-cdef-0011-2233445566ff}");
+    REQUIRE(format_hstring(std::string_view{ "view" }, u'x') == u8"viewx");
+}
@@ -0,0 +1,208 @@
+#include "pch.h"
+
+using namespace xlang;
+
+namespace
+{
+    template <size_t Count>
+    constexpr std::array<guid, Count> make_iids(uint32_t const data1) noexcept
+    {
+        std::array<guid, Count> result{};
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            // Interface IDs that differ only in a few bits, as sequentially allocated IIDs do.
+            result[i] = guid{ data1 + i, 0x0000, 0x0000, { 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46 } };
+        }
+
+        return result;
+    }
+
+    template <size_t Count>
+    void check_perfect_hash()
+    {
+        constexpr auto iids = make_iids<Count>(0x100);
+        constexpr auto params = impl::make_iid_hash_params(iids);
+        static_assert(params.valid);
+
+        std::vector<uint32_t> slots;
+
+        for (auto&& iid : iids)
+        {
+            slots.push_back(impl::iid_hash_slot(impl::fold_guid(iid), params.seed, params.bits));
+        }
+
+        std::sort(slots.begin(), slots.end());
+        REQUIRE(std::adjacent_find(slots.begin(), slots.end()) == slots.end());
+        REQUIRE(slots.back() < (1u << params.bits));
+    }
+}
+
+TEST_CASE("implements,perfect hash")
+{
+    check_perfect_hash<1>();
+    check_perfect_hash<2>();
+    check_perfect_hash<15>();
+    check_perfect_hash<30>();
+    check_perfect_hash<64>();
+
+    // An interface listed twice only needs a slot for its first occurrence.
+    constexpr std::array<guid, 3> duplicates{ guid_of<Windows::Foundation::IUnknown>(), guid_of<Windows::Foundation::IXlangObject>(), guid_of<Windows::Foundation::IUnknown>() };
+    static_assert(impl::make_iid_hash_params(duplicates).valid);
+}
+
+TEST_CASE("implements,QueryInterface")
+{
+    struct Factory : implements<Factory, Windows::Foundation::IActivationFactory, Windows::Foundation::IXlangObject>
+    {
+        Windows::Foundation::IXlangObject ActivateInstance()
+        {
+            return nullptr;
+        }
+    };
+
+    auto factory = make<Factory>();
+    Windows::Foundation::IUnknown unknown = factory;
+
+    REQUIRE(get_abi(unknown.as<Windows::Foundation::IActivationFactory>()) == get_abi(factory));
+    REQUIRE(unknown.try_as<Windows::Foundation::IXlangObject>());
+    REQUIRE(get_abi(unknown.as<Windows::Foundation::IUnknown>()) == get_abi(unknown));
+
+    void* result = nullptr;
+    REQUIRE(get_self<Factory>(factory)->find_interface(guid_of<Windows::Foundation::IActivationFactory>()) == get_abi(factory));
+    REQUIRE(get_self<Factory>(factory)->find_interface(guid_of<impl::IAgileObject>()) == nullptr);
+    REQUIRE(static_cast<impl::unknown_abi*>(get_abi(unknown))->QueryInterface(guid_of<impl::IWeakReference>(), &result) != com_interop_result::success);
+    REQUIRE(result == nullptr);
+}
+
+namespace
+{
+    struct counting_allocator
+    {
+        static inline std::atomic<uint32_t> allocations{};
+        static inline std::atomic<uint32_t> deallocations{};
+
+        static void* allocate(size_t size) noexcept
+        {
+            ++allocations;
+            return std::malloc(size);
+        }
+
+        static void deallocate(void* pointer, size_t) noexcept
+        {
+            ++deallocations;
+            std::free(pointer);
+        }
+    };
+
+    struct scoped_allocation_hooks
+    {
+        explicit scoped_allocation_hooks(allocation_hooks const& hooks) noexcept :
+            m_previous(get_allocation_hooks())
+        {
+            set_allocation_hooks(hooks);
+        }
+
+        ~scoped_allocation_hooks()
+        {
+            set_allocation_hooks(m_previous);
+        }
+
+    private:
+
+        allocation_hooks const m_previous;
+    };
+}
+
+TEST_CASE("implements,pooled")
+{
+    struct Pooled : implements<Pooled, Windows::Foundation::IXlangObject, pooled>
+    {
+        uint32_t m_value{ 123 };
+    };
+
+    // A released object's storage is reused by the next object of the same size on this thread.
+    void* first = get_self<Pooled>(make<Pooled>().as<Windows::Foundation::IXlangObject>());
+    auto second = make_self<Pooled>();
+    REQUIRE(second.get() == first);
+    REQUIRE(second->m_value == 123);
+
+    // Objects may be released on another thread.
+    std::thread([object = std::move(second)]() mutable { object = nullptr; }).join();
+}
+
+TEST_CASE("implements,allocation hooks")
+{
+    struct Pooled : implements<Pooled, Windows::Foundation::IXlangObject, pooled>
+    {
+    };
+
+    struct Unpooled : implements<Unpooled, Windows::Foundation::IXlangObject>
+    {
+    };
+
+    scoped_allocation_hooks hooks{ { counting_allocator::allocate, counting_allocator::deallocate } };
+    counting_allocator::allocations = 0;
+    counting_allocator::deallocations = 0;
+
+    make<Pooled>();
+    make<Unpooled>();
+    REQUIRE(counting_allocator::allocations == 1);
+    REQUIRE(counting_allocator::deallocations == 1);
+
+    {
+        event<delegate<int>> source;
+        int value{};
+        source.add([&](int arg) { value = arg; });
+        source(5);
+        REQUIRE(value == 5);
+        REQUIRE(counting_allocator::allocations == 3); // The delegate and the event array
+    }
+
+    REQUIRE(counting_allocator::deallocations == 3);
+}
+
+TEST_CASE("implements,inline_weak_ref")
+{
+    struct Inline : implements<Inline, Windows::Foundation::IXlangObject, inline_weak_ref>
+    {
+        ~Inline()
+        {
+            // A weak reference taken during destruction never resolves.
+            REQUIRE(!get_weak().get());
+        }
+    };
+
+    struct PooledInline : implements<PooledInline, Windows::Foundation::IXlangObject, inline_weak_ref, pooled>
+    {
+    };
+
+    scoped_allocation_hooks hooks{ { counting_allocator::allocate, counting_allocator::deallocate } };
+    counting_allocator::allocations = 0;
+    counting_allocator::deallocations = 0;
+
+    weak_ref<Inline> weak;
+    weak_ref<Windows::Foundation::IXlangObject> pooled_weak;
+
+    {
+        auto object = make_self<Inline>();
+        weak = object->get_weak();
+        REQUIRE(weak.get() == object);
+
+        auto pooled_object = make<PooledInline>();
+        pooled_weak = pooled_object;
+        REQUIRE(pooled_weak.get() == pooled_object);
+
+        // The control block shares the object's allocation.
+        REQUIRE(counting_allocator::allocations == 1);
+    }
+
+    // The objects are gone but their storage is held by the weak references.
+    REQUIRE(!weak.get());
+    REQUIRE(!pooled_weak.get());
+    REQUIRE(counting_allocator::deallocations == 0);
+
+    pooled_weak = nullptr;
+    REQUIRE(counting_allocator::deallocations == 1);
+    weak = nullptr;
+}
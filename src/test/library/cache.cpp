@@ -0,0 +1,241 @@
+#include "pch.h"
+#include "meta_reader.h"
+#include "meta_writer.h"
+
+using namespace xlang::meta::reader;
+using namespace xlang::meta::writer;
+
+namespace
+{
+    struct temp_folder
+    {
+        temp_folder() : path{ std::filesystem::temp_directory_path() / ("xlang_cache_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())) }
+        {
+            std::filesystem::create_directories(path);
+        }
+
+        ~temp_folder()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+        }
+
+        std::filesystem::path const path;
+    };
+
+    // Writes a winmd defining the interfaces, each given as a namespace and name.
+    std::string write_database(std::filesystem::path const& path, std::vector<std::pair<std::string, std::string>> const& types)
+    {
+        database_writer writer;
+        writer.add_row(table_id::Module, { 0, writer.add_string(path.filename().string()), 0, 0, 0 });
+        writer.add_row(table_id::TypeDef, { 0, writer.add_string("<Module>"), 0, 0, 1, 1 });
+
+        for (auto&& [type_namespace, type_name] : types)
+        {
+            writer.add_row(table_id::TypeDef, { 0x40a1, writer.add_string(type_name), writer.add_string(type_namespace), 0, 1, 1 });
+        }
+
+        writer.save_to_file(path);
+        return path.string();
+    }
+}
+
+TEST_CASE("cache,add_database")
+{
+    temp_folder temp;
+    auto first = write_database(temp.path / "first.winmd", { { "Test", "IFirst" }, { "Test", "IShared" } });
+    auto second = write_database(temp.path / "second.winmd", { { "Test", "IAdded" }, { "Test", "IShared" }, { "Other", "IOther" } });
+
+    cache c{ std::vector<std::string>{ first } };
+    auto& members = c.namespaces().at("Test");
+
+    // Namespaces are categorized when first used.
+    REQUIRE(c.categorized_namespaces() == 0);
+    REQUIRE(members.interfaces.size() == 2);
+    REQUIRE(c.categorized_namespaces() == 1);
+
+    c.add_database(second);
+    REQUIRE(c.databases().size() == 2);
+    REQUIRE(c.find("Other.IOther"));
+    REQUIRE(c.categorized_namespaces() == 1);
+    REQUIRE(c.find("Test.IShared").get_database().path() == first);
+
+    // Namespaces are updated in place and stay sorted by name.
+    REQUIRE(&c.namespaces().at("Test") == &members);
+    REQUIRE(members.interfaces.size() == 3);
+    REQUIRE(members.interfaces[0].TypeName() == "IAdded");
+    REQUIRE(members.interfaces[1].TypeName() == "IFirst");
+    REQUIRE(members.interfaces[2].TypeName() == "IShared");
+
+    // Removing the database that defined a type first exposes the definition it hid.
+    REQUIRE(c.remove_database(first));
+    REQUIRE(!c.remove_database(first));
+    REQUIRE(!c.find("Test.IFirst"));
+    REQUIRE(c.find("Test.IShared").get_database().path() == second);
+    REQUIRE(&c.namespaces().at("Test") == &members);
+    REQUIRE(members.interfaces.size() == 2);
+    REQUIRE(c.namespaces().find("Test")->first == "Test");
+
+    REQUIRE(c.remove_database(second));
+    REQUIRE(c.namespaces().empty());
+    REQUIRE(c.databases().empty());
+}
+
+TEST_CASE("cache,concurrent reload")
+{
+    temp_folder temp;
+    auto first = write_database(temp.path / "first.winmd", { { "Test", "IFirst" } });
+    auto second = write_database(temp.path / "second.winmd", { { "Test", "ISecond" }, { "Reloaded", "IReloaded" } });
+
+    cache c{ std::vector<std::string>{ first, second } };
+    std::atomic<bool> done{};
+    std::atomic<uint32_t> lookups{};
+    std::atomic<uint32_t> failures{};
+    std::vector<std::thread> readers;
+
+    // Readers holding the lock see the second file either before or after each reload, never
+    // without it, and what they found stays valid until they release the lock.
+    for (int reader = 0; reader < 2; ++reader)
+    {
+        readers.emplace_back([&]
+        {
+            while (!done)
+            {
+                {
+                    auto const guard = c.lock_shared();
+                    auto const type = c.find("Reloaded", "IReloaded");
+                    auto const ns = c.namespaces().find("Test");
+
+                    if (!type || type.TypeName() != "IReloaded" || ns == c.namespaces().end() || ns->second.interfaces.size() != 2)
+                    {
+                        ++failures;
+                    }
+
+                    ++lookups;
+                }
+
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    while (lookups == 0)
+    {
+        std::this_thread::yield();
+    }
+
+    for (int reload = 0; reload < 100; ++reload)
+    {
+        c.reload({ second });
+    }
+
+    done = true;
+
+    for (auto&& reader : readers)
+    {
+        reader.join();
+    }
+
+    REQUIRE(failures == 0);
+    REQUIRE(c.databases().size() == 2);
+    REQUIRE(c.find("Reloaded.IReloaded").get_database().path() == second);
+}
+
+#if defined(__linux__)
+
+TEST_CASE("cache,cache_watcher")
+{
+    temp_folder temp;
+    auto first = write_database(temp.path / "first.winmd", { { "Test", "IFirst" } });
+    auto second = write_database(temp.path / "second.winmd", { { "Test", "ISecond" } });
+
+    cache c{ std::vector<std::string>{ first, second } };
+    cache_watcher watcher{ c };
+    REQUIRE(watcher.refresh().empty());
+
+    // A file replaced by renaming another over it is reloaded. Other files are left alone.
+    auto const& unchanged = c.databases().back();
+    write_database(temp.path / "first.tmp", { { "Test", "IReplaced" } });
+    std::filesystem::rename(temp.path / "first.tmp", first);
+
+    REQUIRE(watcher.refresh(5000) == std::vector<std::string>{ first });
+    REQUIRE(!c.find("Test.IFirst"));
+    REQUIRE(c.find("Test.IReplaced"));
+    REQUIRE(&c.find("Test.ISecond").get_database() == &unchanged);
+
+    std::filesystem::remove(second);
+    REQUIRE(watcher.refresh(5000) == std::vector<std::string>{ second });
+    REQUIRE(!c.find("Test.ISecond"));
+    REQUIRE(c.databases().size() == 1);
+}
+
+#endif
+
+namespace
+{
+    struct counted
+    {
+        static inline uint32_t instances{};
+
+        explicit counted(cache const& c) : types(c.namespaces().at("Test").types.size())
+        {
+            ++instances;
+        }
+
+        size_t const types;
+    };
+}
+
+TEST_CASE("cache,shared_cache")
+{
+    temp_folder temp;
+    auto first = write_database(temp.path / "first.winmd", { { "Test", "IFirst" } });
+    auto second = write_database(temp.path / "second.winmd", { { "Test", "ISecond" } });
+
+    // The same files in any order and spelling share one cache.
+    auto shared = shared_cache::get({ first, second });
+    REQUIRE(shared_cache::get({ (temp.path / "." / "second.winmd").string(), first, second }) == shared);
+    REQUIRE(shared_cache::get({ first }) != shared);
+    REQUIRE(shared->files().size() == 2);
+    REQUIRE(shared->get().databases().size() == 2);
+
+    // Extensions are built once per cache.
+    REQUIRE(shared->extension<counted>().types == 2);
+    REQUIRE(&shared->extension<counted>() == &shared_cache::get({ second, first })->extension<counted>());
+    REQUIRE(counted::instances == 1);
+
+    // The cache is released with its last user.
+    std::weak_ptr<shared_cache const> released = shared;
+    shared = nullptr;
+    REQUIRE(released.expired());
+    REQUIRE(shared_cache::get({ first, second })->extension<counted>().types == 2);
+    REQUIRE(counted::instances == 2);
+}
+
+TEST_CASE("cache,memory_report")
+{
+    temp_folder temp;
+    auto first = write_database(temp.path / "first.winmd", { { "Test", "IFirst" }, { "Test", "ISecond" } });
+
+    cache c{ std::vector<std::string>{ first } };
+    auto report = c.memory_report();
+    REQUIRE(report.structures.size() == 5);
+
+    auto const& files = report.structures[0];
+    REQUIRE(files.name == "files");
+    REQUIRE(files.mapped == std::filesystem::file_size(first));
+    // The writer ends the image with the blob heap, so the database pads a copy of it.
+    REQUIRE(files.vectors >= blob_cursor::padding);
+    REQUIRE(files.vectors < files.mapped);
+    REQUIRE(report.structures[1].nodes >= sizeof(database));
+    REQUIRE(report.structures[3].nodes > 0);
+
+    // Category lists are only counted once they exist.
+    REQUIRE(report.structures[4].vectors == 0);
+    REQUIRE(c.namespaces().at("Test").interfaces.size() == 2);
+    REQUIRE(c.memory_report().structures[4].vectors >= 2 * sizeof(TypeDef));
+
+    auto const total = report.total();
+    REQUIRE(total.mapped == files.mapped);
+    REQUIRE(total.nodes == report.structures[1].nodes + report.structures[2].nodes + report.structures[3].nodes);
+}
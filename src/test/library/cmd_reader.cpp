@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "cmd_reader.h"
+
+using namespace xlang;
+
+TEST_CASE("glob_match")
+{
+    REQUIRE(impl::glob_match("*.winmd", "Windows.Foundation.winmd"));
+    REQUIRE(impl::glob_match("Windows.*.winmd", "Windows.Foundation.winmd"));
+    REQUIRE(impl::glob_match("?bj", "obj"));
+    REQUIRE(impl::glob_match("*", ""));
+    REQUIRE(!impl::glob_match("*.winmd", "Windows.Foundation.dll"));
+    REQUIRE(!impl::glob_match("obj", "objects"));
+}
+
+TEST_CASE("files")
+{
+    auto const root = std::filesystem::temp_directory_path() / "xlang_test_library_files";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "a" / "b");
+    std::filesystem::create_directories(root / "obj");
+
+    for (auto&& path : { root / "top.winmd", root / "a" / "one.winmd", root / "a" / "b" / "two.winmd", root / "obj" / "skip.winmd", root / "a" / "notes.txt" })
+    {
+        std::ofstream{ path };
+    }
+
+    static cmd::option options[]{ { "input", 1 } };
+    std::string const input = root.string();
+    char const* args[]{ "test", "-input", input.c_str() };
+    cmd::reader const reader{ 3, args, options };
+    auto const winmd = [](std::string const& path) { return std::filesystem::path{ path }.extension() == ".winmd"; };
+
+    REQUIRE(reader.files("input", winmd).size() == 4);
+
+    cmd::file_search search;
+    search.depth = 1;
+    search.exclude = { "obj" };
+    auto const files = reader.files("input", winmd, search);
+
+    auto const canonical = std::filesystem::canonical(root);
+    REQUIRE(files == std::set<std::string>{ (canonical / "a" / "one.winmd").string(), (canonical / "top.winmd").string() });
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("files,links")
+{
+    auto const root = std::filesystem::temp_directory_path() / "xlang_test_library_links";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "s" / "t" / "u");
+    std::filesystem::create_directories(root / "p" / "q");
+    std::ofstream{ root / "s" / "t" / "u" / "deep.winmd" };
+    std::ofstream{ root / "s" / "top.winmd" };
+
+    // A cycle back to the root, a deeper second route to s/t, and a second name for a file.
+    std::filesystem::create_directory_symlink(root, root / "s" / "loop");
+    std::filesystem::create_directory_symlink(root / "s" / "t", root / "p" / "q" / "t");
+    std::filesystem::create_symlink(root / "s" / "top.winmd", root / "p" / "alias.winmd");
+
+    static cmd::option options[]{ { "input", 1 }, { "scan-depth", 0, 1 }, { "scan-skip" } };
+    std::string const input = root.string();
+    char const* args[]{ "test", "-input", input.c_str(), "-scan-depth", "3", "-scan-skip", "obj" };
+    cmd::reader const reader{ 7, args, options };
+
+    auto const search = reader.search();
+    REQUIRE(search.depth == 3);
+    REQUIRE(search.include.empty());
+    REQUIRE(search.exclude == std::vector<std::string>{ "obj" });
+
+    // s/t/u is three folders down by the short route and four through p/q/t, so it is within the limit.
+    auto const canonical = std::filesystem::canonical(root);
+    std::set<std::string> const expected{ (canonical / "s" / "t" / "u" / "deep.winmd").string(), (canonical / "s" / "top.winmd").string() };
+    REQUIRE(reader.files("input", search) == expected);
+
+    char const* bad_args[]{ "test", "-input", input.c_str(), "-scan-depth", "deep" };
+    REQUIRE_THROWS_WITH((cmd::reader{ 5, bad_args, options }.search()), "Option '-scan-depth' requires a number");
+
+    std::filesystem::remove_all(root);
+}
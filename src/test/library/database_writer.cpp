@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "meta_reader.h"
+#include "meta_writer.h"
+
+using namespace xlang::meta;
+using namespace xlang::meta::reader;
+using namespace xlang::meta::writer;
+
+TEST_CASE("database_writer")
+{
+    database_writer writer;
+    writer.add_row(table_id::Module, { 0, writer.add_string("Test.winmd"), writer.add_guid({ 1, 2, 3 }), 0, 0 });
+
+    uint32_t const mscorlib = writer.add_row(table_id::AssemblyRef, { 4, 0, 0, writer.add_string("mscorlib"), 0, 0 });
+    uint32_t const object = writer.add_row(table_id::TypeRef, { make_coded_index(ResolutionScope::AssemblyRef, mscorlib), writer.add_string("Object"), writer.add_string("System") });
+
+    writer.add_row(table_id::TypeDef, { 0, writer.add_string("<Module>"), 0, 0, 1, 1 });
+    uint32_t const widget = writer.add_row(table_id::TypeDef, { 0x1, writer.add_string("Widget"), writer.add_string("Test"), make_coded_index(TypeDefOrRef::TypeRef, object), 1, 1 });
+    uint8_t const signature[]{ 0x06, 0x08 };
+    writer.add_row(table_id::Field, { 0x1, writer.add_string("Value"), writer.add_blob(std::begin(signature), std::end(signature)) });
+    writer.add_row(table_id::TypeDef, { 0x1, writer.add_string("Gadget"), writer.add_string("Test"), make_coded_index(TypeDefOrRef::TypeRef, object), 2, 1 });
+
+    // Rows are added out of order and sorted by parent when the database is saved.
+    uint32_t const constructor = writer.add_row(table_id::MemberRef, { make_coded_index(MemberRefParent::TypeRef, object), writer.add_string(".ctor"), writer.add_blob(std::begin(signature), std::end(signature)) });
+    writer.add_row(table_id::CustomAttribute, { make_coded_index(HasCustomAttribute::TypeDef, widget + 1), make_coded_index(CustomAttributeType::MemberRef, constructor), 0 });
+    writer.add_row(table_id::CustomAttribute, { make_coded_index(HasCustomAttribute::TypeDef, widget), make_coded_index(CustomAttributeType::MemberRef, constructor), 0 });
+
+    REQUIRE(writer.add_string("Test") == writer.add_string("Test"));
+    REQUIRE(writer.add_blob(std::begin(signature), std::end(signature)) == writer.add_blob({ 0x06, 0x08 }));
+
+    database db{ writer.save_to_memory() };
+
+    REQUIRE(db.TypeDef.size() == 3);
+    REQUIRE(db.TypeDef[1].TypeNamespace() == "Test");
+    REQUIRE(db.TypeDef[1].TypeName() == "Widget");
+    REQUIRE(db.TypeDef[1].Extends().TypeRef().TypeName() == "Object");
+    REQUIRE(db.TypeDef[1].FieldList().first.Name() == "Value");
+    REQUIRE(db.TypeDef[2].TypeName() == "Gadget");
+    REQUIRE(db.CustomAttribute[0].Parent().type() == HasCustomAttribute::TypeDef);
+    REQUIRE(db.CustomAttribute[0].Parent().index() == widget - 1);
+    REQUIRE(db.CustomAttribute[1].Parent().index() == widget);
+    REQUIRE(db.Module[0].Name() == "Test.winmd");
+}
+
+TEST_CASE("database_writer,wide indexes")
+{
+    database_writer writer;
+    writer.add_row(table_id::Module, { 0, writer.add_string("Test.winmd"), 0, 0, 0 });
+
+    // Enough rows and string data that table and heap indexes need four bytes.
+    for (uint32_t i{}; i < 70000; ++i)
+    {
+        writer.add_row(table_id::TypeRef, { make_coded_index(ResolutionScope::Module, 1), writer.add_string("Type" + std::to_string(i)), writer.add_string("Test") });
+    }
+
+    database db{ writer.save_to_memory() };
+
+    REQUIRE(db.TypeRef.size() == 70000);
+    REQUIRE(db.TypeRef[69999].TypeName() == "Type69999");
+    REQUIRE(db.TypeRef[69999].ResolutionScope().type() == ResolutionScope::Module);
+}
+
+TEST_CASE("database,in place")
+{
+    database_writer writer;
+    writer.add_row(table_id::Module, { 0, writer.add_string("Test.winmd"), 0, 0, 0 });
+    writer.add_row(table_id::TypeDef, { 0, writer.add_string("<Module>"), 0, 0, 1, 1 });
+    writer.add_row(table_id::TypeDef, { 0x40a1, writer.add_string("IWidget"), writer.add_string("Test"), 0, 1, 1 });
+
+    auto image = std::make_shared<std::vector<uint8_t> const>(writer.save_to_memory());
+    std::weak_ptr<std::vector<uint8_t> const> released = image;
+
+    {
+        cache c{ { { { image->data(), image->data() + image->size() }, image } } };
+        image = nullptr;
+        REQUIRE(!released.expired());
+
+        // Strings are read from the caller's buffer rather than a copy.
+        auto type = c.find_required("Test.IWidget");
+        auto buffer = released.lock();
+        REQUIRE(type.TypeName().data() >= reinterpret_cast<char const*>(buffer->data()));
+        REQUIRE(type.TypeName().data() < reinterpret_cast<char const*>(buffer->data() + buffer->size()));
+        REQUIRE(c.databases().front().path().empty());
+    }
+
+    REQUIRE(released.expired());
+}
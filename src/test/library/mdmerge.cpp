@@ -0,0 +1,167 @@
+#include "pch.h"
+#include "meta_reader.h"
+#include "meta_writer.h"
+#include "task_group.h"
+#include "merger.h"
+
+using namespace xlang;
+using namespace xlang::meta::reader;
+using namespace xlang::meta::writer;
+
+namespace
+{
+    cache::image save_image(database_writer& writer)
+    {
+        auto image = std::make_shared<std::vector<uint8_t> const>(writer.save_to_memory());
+        return { { image->data(), image->data() + image->size() }, image };
+    }
+
+    void add_assembly(database_writer& writer, std::string_view const& name)
+    {
+        writer.add_row(table_id::Module, { 0, writer.add_string(std::string{ name } + ".winmd"), 0, 0, 0 });
+        writer.add_row(table_id::Assembly, { 0x8004, ~0ull, 0x200, 0, writer.add_string(name), 0 });
+        writer.add_row(table_id::TypeDef, { 0, writer.add_string("<Module>"), 0, 0, 1, 1 });
+    }
+
+    // Defines Test.IWidget, Test.MarkerAttribute, Test.Button and Other.IGadget. Button implements
+    // IWidget and Test.IShared, which is defined by the second input, and has a field whose type is
+    // nested in IShared.
+    cache::image write_first()
+    {
+        database_writer writer;
+        add_assembly(writer, "First");
+
+        uint32_t const second = writer.add_row(table_id::AssemblyRef, { ~0ull, 0x200, 0, writer.add_string("Second"), 0, 0 });
+        uint32_t const shared = writer.add_row(table_id::TypeRef, { make_coded_index(ResolutionScope::AssemblyRef, second), writer.add_string("IShared"), writer.add_string("Test") });
+        uint32_t const nested = writer.add_row(table_id::TypeRef, { make_coded_index(ResolutionScope::TypeRef, shared), writer.add_string("Nested"), 0 });
+
+        uint32_t const method = writer.add_blob({ 0x20, 0x00, 0x01 });
+        uint32_t const field = writer.add_blob({ 0x06, 0x12, static_cast<uint8_t>(make_coded_index(TypeDefOrRef::TypeRef, nested)) });
+
+        uint32_t const widget_interface = writer.add_row(table_id::TypeDef, { 0x40a1, writer.add_string("IWidget"), writer.add_string("Test"), 0, 1, 1 });
+        uint32_t const interface_run = writer.add_row(table_id::MethodDef, { 0, 0, 0x05c6, writer.add_string("Run"), method, 1 });
+
+        writer.add_row(table_id::TypeDef, { 0x4101, writer.add_string("MarkerAttribute"), writer.add_string("Test"), 0, 1, 2 });
+        uint32_t const constructor = writer.add_row(table_id::MethodDef, { 0, 0, 0x1886, writer.add_string(".ctor"), method, 1 });
+
+        uint32_t const button = writer.add_row(table_id::TypeDef, { 0x4101, writer.add_string("Button"), writer.add_string("Test"), 0, 1, 3 });
+        writer.add_row(table_id::Field, { 0x1, writer.add_string("Value"), field });
+        uint32_t const run = writer.add_row(table_id::MethodDef, { 0, 0, 0x01e6, writer.add_string("Run"), method, 1 });
+
+        writer.add_row(table_id::TypeDef, { 0x40a1, writer.add_string("IGadget"), writer.add_string("Other"), 0, 2, 4 });
+
+        writer.add_row(table_id::InterfaceImpl, { button, make_coded_index(TypeDefOrRef::TypeDef, widget_interface) });
+        writer.add_row(table_id::InterfaceImpl, { button, make_coded_index(TypeDefOrRef::TypeRef, shared) });
+        writer.add_row(table_id::MethodImpl, { button, make_coded_index(MethodDefOrRef::MethodDef, run), make_coded_index(MethodDefOrRef::MethodDef, interface_run) });
+        writer.add_row(table_id::CustomAttribute, { make_coded_index(HasCustomAttribute::TypeDef, button), make_coded_index(CustomAttributeType::MethodDef, constructor), writer.add_blob({ 0x01, 0x00, 0x00, 0x00 }) });
+
+        return save_image(writer);
+    }
+
+    // Defines Test.IShared and the interface Nested within it.
+    cache::image write_second()
+    {
+        database_writer writer;
+        add_assembly(writer, "Second");
+
+        uint32_t const shared = writer.add_row(table_id::TypeDef, { 0x40a1, writer.add_string("IShared"), writer.add_string("Test"), 0, 1, 1 });
+        uint32_t const nested = writer.add_row(table_id::TypeDef, { 0x40a2, writer.add_string("Nested"), 0, 0, 1, 1 });
+        writer.add_row(table_id::NestedClass, { nested, shared });
+
+        return save_image(writer);
+    }
+
+    TypeDef find_type(database const& db, std::string_view const& type_name)
+    {
+        for (auto&& type : db.TypeDef)
+        {
+            if (type.TypeName() == type_name)
+            {
+                return type;
+            }
+        }
+
+        FAIL("Type not found");
+        return {};
+    }
+
+    coded_index<TypeDefOrRef> field_type(Field const& field)
+    {
+        auto const signature = field.get_database().get_blob(field.get_value<uint32_t>(2));
+        REQUIRE(signature.size() == 3);
+        return { &field.get_database().TypeDef, signature.begin()[2] };
+    }
+}
+
+TEST_CASE("mdmerge,filtered")
+{
+    cache c{ std::vector<cache::image>{ write_first(), write_second() } };
+    merger m{ c, filter{ std::vector<std::string>{ "Test.Button", "Test.IShared" }, std::vector<std::string>{} }, "Merged.winmd" };
+    REQUIRE(m.type_count() == 2);
+
+    database db{ m.save() };
+    REQUIRE(db.TypeDef.size() == 3);
+    auto const button = find_type(db, "Button");
+
+    // References to merged types become TypeDefs. Others refer back to the input that defines them.
+    REQUIRE(db.InterfaceImpl.size() == 2);
+    auto const widget_interface = db.InterfaceImpl[0].Interface();
+    REQUIRE(widget_interface.type() == TypeDefOrRef::TypeRef);
+    REQUIRE(widget_interface.TypeRef().TypeName() == "IWidget");
+    REQUIRE(widget_interface.TypeRef().ResolutionScope().AssemblyRef().Name() == "First");
+    REQUIRE(db.InterfaceImpl[1].Interface().type() == TypeDefOrRef::TypeDef);
+    REQUIRE(db.InterfaceImpl[1].Interface().TypeDef().TypeName() == "IShared");
+
+    // A type nested in a merged type, but not merged itself, is scoped by a TypeRef to its enclosing type.
+    auto const nested = field_type(button.FieldList().first);
+    REQUIRE(nested.type() == TypeDefOrRef::TypeRef);
+    REQUIRE(nested.TypeRef().TypeName() == "Nested");
+    REQUIRE(nested.TypeRef().ResolutionScope().type() == ResolutionScope::TypeRef);
+    REQUIRE(nested.TypeRef().ResolutionScope().TypeRef().TypeName() == "IShared");
+    REQUIRE(nested.TypeRef().ResolutionScope().TypeRef().ResolutionScope().AssemblyRef().Name() == "Second");
+
+    // Methods of types that aren't merged are referred to through MemberRefs.
+    REQUIRE(db.MethodImpl.size() == 1);
+    REQUIRE(db.MethodImpl[0].MethodBody().MethodDef().Name() == "Run");
+    auto const declaration = db.MethodImpl[0].MethodDeclaration();
+    REQUIRE(declaration.type() == MethodDefOrRef::MemberRef);
+    REQUIRE(declaration.MemberRef().Name() == "Run");
+    REQUIRE(declaration.MemberRef().Class().TypeRef().TypeName() == "IWidget");
+
+    REQUIRE(db.CustomAttribute.size() == 1);
+    REQUIRE(db.CustomAttribute[0].Parent().get_row<TypeDef>() == button);
+    auto const constructor = db.CustomAttribute[0].Type();
+    REQUIRE(constructor.type() == CustomAttributeType::MemberRef);
+    REQUIRE(constructor.MemberRef().Name() == ".ctor");
+    REQUIRE(constructor.MemberRef().Class().TypeRef().TypeName() == "MarkerAttribute");
+    REQUIRE(constructor.MemberRef().Class().TypeRef().ResolutionScope().AssemblyRef().Name() == "First");
+}
+
+TEST_CASE("mdmerge,union")
+{
+    cache c{ std::vector<cache::image>{ write_first(), write_second() } };
+    merger m{ c, filter{ std::vector<std::string>{ "" }, std::vector<std::string>{ "Other" } }, "Merged.winmd" };
+    REQUIRE(m.type_count() == 5);
+
+    database db{ m.save() };
+    REQUIRE(db.TypeDef.size() == 6);
+    REQUIRE(db.TypeRef.size() == 0);
+    REQUIRE(db.MemberRef.size() == 0);
+    auto const button = find_type(db, "Button");
+
+    REQUIRE(db.NestedClass.size() == 1);
+    auto const nested = field_type(button.FieldList().first);
+    REQUIRE(nested.type() == TypeDefOrRef::TypeDef);
+    REQUIRE(nested.index() == db.NestedClass[0].get_value<uint32_t>(0) - 1);
+    REQUIRE(db.TypeDef[db.NestedClass[0].get_value<uint32_t>(1) - 1].TypeName() == "IShared");
+
+    // The interface method is defined after the class that implements it.
+    REQUIRE(db.MethodImpl.size() == 1);
+    auto const declaration = db.MethodImpl[0].MethodDeclaration();
+    REQUIRE(declaration.type() == MethodDefOrRef::MethodDef);
+    REQUIRE(declaration.MethodDef().Parent().TypeName() == "IWidget");
+
+    REQUIRE(db.CustomAttribute.size() == 1);
+    REQUIRE(db.CustomAttribute[0].Type().type() == CustomAttributeType::MethodDef);
+    REQUIRE(db.CustomAttribute[0].Type().MethodDef().Parent().TypeName() == "MarkerAttribute");
+}
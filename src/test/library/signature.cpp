@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "meta_reader.h"
+
+using namespace xlang::meta::reader;
+
+namespace
+{
+    std::vector<uint8_t> compress(uint32_t const value)
+    {
+        if (value < 0x80)
+        {
+            return { static_cast<uint8_t>(value) };
+        }
+
+        if (value < 0x4000)
+        {
+            return { static_cast<uint8_t>(0x80 | (value >> 8)), static_cast<uint8_t>(value) };
+        }
+
+        return { static_cast<uint8_t>(0xc0 | (value >> 24)), static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value) };
+    }
+}
+
+TEST_CASE("uncompress_unsigned")
+{
+    for (uint32_t const value : { 0u, 1u, 0x7fu, 0x80u, 0x1234u, 0x3fffu, 0x4000u, 0x123456u, 0x1fffffffu })
+    {
+        auto bytes = compress(value);
+        auto const length = bytes.size();
+
+        // Integers at the end of a blob are decoded without reading past it.
+        byte_view exact{ bytes.data(), bytes.data() + length };
+        REQUIRE(uncompress_unsigned(exact) == value);
+        REQUIRE(exact.size() == 0);
+
+        // Integers followed by more data are decoded from a whole word.
+        bytes.insert(bytes.end(), { 0xff, 0xff, 0xff, 0xff });
+        byte_view padded{ bytes.data(), bytes.data() + bytes.size() };
+        REQUIRE(uncompress_unsigned(padded) == value);
+        REQUIRE(padded.size() == 4);
+
+        blob_cursor cursor{ { bytes.data(), bytes.data() + bytes.size() } };
+        REQUIRE(cursor.compressed_size() == length);
+        REQUIRE(cursor.read_compressed() == value);
+        REQUIRE(cursor.read_byte() == 0xff);
+        REQUIRE(cursor.read_bytes(3).size() == 3);
+        REQUIRE(cursor.empty());
+    }
+
+    uint8_t const invalid[]{ 0xe0, 0, 0, 0 };
+    byte_view invalid_view{ std::begin(invalid), std::end(invalid) };
+    REQUIRE_THROWS_WITH(uncompress_unsigned(invalid_view), "Invalid compressed integer in blob");
+
+    uint8_t const truncated[]{ 0xc0, 0 };
+    byte_view truncated_view{ std::begin(truncated), std::end(truncated) };
+    REQUIRE_THROWS_WITH(uncompress_unsigned(truncated_view), "Buffer too small");
+
+    // The cursor doesn't check each read, so its blob is followed by padding as in a database.
+    std::vector<uint8_t> padded{ std::begin(truncated), std::end(truncated) };
+    padded.resize(padded.size() + blob_cursor::padding);
+    blob_cursor cursor{ { padded.data(), padded.data() + std::size(truncated) } };
+    REQUIRE_THROWS_WITH(cursor.read_bytes(3), "Buffer too small");
+    REQUIRE(cursor.size() == 2);
+    REQUIRE(cursor.read_compressed() == 0);
+    REQUIRE(cursor.empty());
+    REQUIRE_THROWS_WITH(cursor.check(), "Buffer too small");
+}
+
+TEST_CASE("MethodDefSig")
+{
+    // HasThis, two parameters, returning void, taking an int32 and a string.
+    std::vector<uint8_t> blob{ 0x20, 0x02, 0x01, 0x08, 0x0e };
+    auto const length = blob.size();
+    blob.resize(length + blob_cursor::padding, 0x08);
+
+    blob_cursor cursor{ { blob.data(), blob.data() + length } };
+    MethodDefSig const signature{ nullptr, cursor };
+    REQUIRE(cursor.empty());
+    REQUIRE(!signature.ReturnType());
+    REQUIRE(distance(signature.Params()) == 2);
+    REQUIRE(std::get<ElementType>(signature.Params().first[1].Type().Type()) == ElementType::String);
+
+    // A blob that ends within its last parameter is rejected once that parameter is parsed, even
+    // though the bytes after it would parse.
+    std::vector<uint8_t> value_type{ 0x20, 0x01, 0x01, 0x11, 0x80, 0x10 };
+    value_type.resize(value_type.size() + blob_cursor::padding);
+    blob_cursor truncated{ { value_type.data(), value_type.data() + 5 } };
+    REQUIRE_THROWS_WITH((MethodDefSig{ nullptr, truncated }), "Buffer too small");
+}
@@ -0,0 +1,56 @@
+#include "benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace xlang::benchmark;
+
+namespace
+{
+    // Resolves a class name against the test abi_component, which must be next to the benchmark.
+    void get_activation_factory(state& s, std::u16string_view class_name, bool expect_success)
+    {
+        xlang_string_header header{};
+        xlang_string str{};
+        static_cast<void>(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &header, &str));
+
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            xlang_unknown* factory{};
+            xlang_error_info* result = xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory));
+            if ((result == nullptr) != expect_success)
+            {
+                std::fprintf(stderr, "Unexpected activation result\n");
+                std::abort();
+            }
+
+            if (factory)
+            {
+                factory->Release();
+            }
+            if (result)
+            {
+                result->Release();
+            }
+        }
+
+        xlang_delete_string(str);
+    }
+
+    [[maybe_unused]] bool const registered = []
+    {
+        add("activation/get_factory/hit", [](state& s)
+        {
+            get_activation_factory(s, u"AbiComponent.Widget", true);
+        });
+        add("activation/get_factory/miss_class", [](state& s)
+        {
+            get_activation_factory(s, u"AbiComponent.Missing", false);
+        });
+        add("activation/get_factory/miss_namespace", [](state& s)
+        {
+            get_activation_factory(s, u"Benchmark.Missing.Widget", false);
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <pal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Minimal benchmark harness for the PAL. Each benchmark is a function that runs its operation
+// state.iterations() times. The harness grows the iteration count until a run takes at least
+// the minimum time, then reports the median of several runs.
+
+namespace xlang::benchmark
+{
+    struct state
+    {
+        explicit state(uint64_t iterations) noexcept : m_iterations(iterations)
+        {
+        }
+
+        uint64_t iterations() const noexcept
+        {
+            return m_iterations;
+        }
+
+        // Per-iteration counters reported alongside the timing, e.g. allocations per operation.
+        void counter(std::string const& name, double value)
+        {
+            m_counters[name] = value;
+        }
+
+        std::map<std::string, double> const& counters() const noexcept
+        {
+            return m_counters;
+        }
+
+        // Excludes setup work inside the benchmark function from the measured time.
+        void pause() noexcept
+        {
+            m_paused_at = std::chrono::steady_clock::now();
+        }
+
+        void resume() noexcept
+        {
+            m_excluded += std::chrono::steady_clock::now() - m_paused_at;
+        }
+
+        std::chrono::nanoseconds excluded() const noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(m_excluded);
+        }
+
+    private:
+        uint64_t m_iterations;
+        std::map<std::string, double> m_counters;
+        std::chrono::steady_clock::time_point m_paused_at;
+        std::chrono::steady_clock::duration m_excluded{};
+    };
+
+    using function = std::function<void(state&)>;
+
+    struct registration
+    {
+        std::string name;
+        function body;
+    };
+
+    inline std::vector<registration>& registry()
+    {
+        static std::vector<registration> benchmarks;
+        return benchmarks;
+    }
+
+    inline void add(std::string name, function body)
+    {
+        registry().push_back({ std::move(name), std::move(body) });
+    }
+
+    // Keeps the compiler from discarding a value computed only for timing purposes.
+    template <typename T>
+    inline void do_not_optimize(T const& value) noexcept
+    {
+#if XLANG_COMPILER_MSVC
+        static_cast<void>(*const_cast<T const volatile*>(&value));
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    // Helpers to call the UTF-8 or UTF-16 flavor of a PAL string function from templated benchmarks.
+    template <typename char_type>
+    inline xlang_error_info* create_string(char_type const* source, uint32_t length, xlang_string* str) noexcept
+    {
+        if constexpr (std::is_same_v<char_type, xlang_char8>)
+        {
+            return xlang_create_string_utf8(source, length, str);
+        }
+        else
+        {
+            return xlang_create_string_utf16(source, length, str);
+        }
+    }
+
+    template <typename char_type>
+    inline xlang_error_info* create_string_reference(char_type const* source, uint32_t length, xlang_string_header* header, xlang_string* str) noexcept
+    {
+        if constexpr (std::is_same_v<char_type, xlang_char8>)
+        {
+            return xlang_create_string_reference_utf8(source, length, header, str);
+        }
+        else
+        {
+            return xlang_create_string_reference_utf16(source, length, header, str);
+        }
+    }
+
+    template <typename char_type>
+    inline xlang_error_info* get_string_raw_buffer(xlang_string str, char_type const** buffer, uint32_t* length) noexcept
+    {
+        if constexpr (std::is_same_v<char_type, xlang_char8>)
+        {
+            return xlang_get_string_raw_buffer_utf8(str, buffer, length);
+        }
+        else
+        {
+            return xlang_get_string_raw_buffer_utf16(str, buffer, length);
+        }
+    }
+
+    template <typename char_type>
+    inline std::basic_string<char_type> make_ascii_string(uint32_t length)
+    {
+        std::basic_string<char_type> result(length, char_type{});
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            result[i] = static_cast<char_type>('a' + i % 26);
+        }
+        return result;
+    }
+
+    template <typename char_type>
+    inline constexpr std::string_view encoding_name = std::is_same_v<char_type, xlang_char8> ? "utf8" : "utf16";
+
+    inline constexpr uint32_t string_lengths[] = { 1, 8, 32, 128, 1024 };
+}
@@ -0,0 +1,80 @@
+#include "benchmark.h"
+
+using namespace xlang::benchmark;
+
+namespace
+{
+    void originate(state& s, xlang_result code, xlang_string message, xlang_string projection_identifier)
+    {
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            xlang_error_info* error = xlang_originate_error(code, message, projection_identifier);
+            do_not_optimize(error);
+            error->Release();
+        }
+    }
+
+    void originate_propagate(state& s, xlang_string message, xlang_string projection_identifier)
+    {
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            xlang_error_info* error = xlang_originate_error(xlang_result::invalid_arg, message, projection_identifier);
+            error->PropagateError(projection_identifier, nullptr, nullptr, nullptr);
+            do_not_optimize(error);
+            error->Release();
+        }
+    }
+
+    struct error_strings
+    {
+        error_strings()
+        {
+            std::string_view const message_text{ "The parameter is incorrect." };
+            std::string_view const projection_text{ "benchmark" };
+            static_cast<void>(xlang_create_string_utf8(message_text.data(), static_cast<uint32_t>(message_text.size()), &message));
+            static_cast<void>(xlang_create_string_utf8(projection_text.data(), static_cast<uint32_t>(projection_text.size()), &projection_identifier));
+        }
+
+        ~error_strings()
+        {
+            xlang_delete_string(message);
+            xlang_delete_string(projection_identifier);
+        }
+
+        xlang_string message{};
+        xlang_string projection_identifier{};
+    };
+
+    error_strings const& strings()
+    {
+        static error_strings const values;
+        return values;
+    }
+
+    [[maybe_unused]] bool const registered = []
+    {
+        add("error/originate/code_only", [](state& s)
+        {
+            originate(s, xlang_result::bounds, nullptr, nullptr);
+        });
+        add("error/originate/projection_identifier", [](state& s)
+        {
+            originate(s, xlang_result::bounds, nullptr, strings().projection_identifier);
+        });
+        add("error/originate/message", [](state& s)
+        {
+            originate(s, xlang_result::invalid_arg, strings().message, strings().projection_identifier);
+        });
+        add("error/originate_propagate/message", [](state& s)
+        {
+            originate_propagate(s, strings().message, strings().projection_identifier);
+        });
+        add("error/originate/code_only/lightweight", [](state& s)
+        {
+            auto const previous = xlang_set_error_mode(xlang_error_mode::lightweight);
+            originate(s, xlang_result::bounds, nullptr, strings().projection_identifier);
+            xlang_set_error_mode(previous);
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,120 @@
+#include "benchmark.h"
+
+#include <xlang/base.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace xlang::benchmark;
+
+namespace
+{
+    using handler = xlang::delegate<int>;
+
+    // The previous implementation of xlang::event, which takes a lock on every raise. Kept here as
+    // the baseline for the lock-free raise path.
+    template <typename Delegate>
+    struct locked_event
+    {
+        using delegate_array = xlang::com_ptr<xlang::impl::event_array<Delegate>>;
+
+        void add(Delegate const& delegate)
+        {
+            std::lock_guard const change_guard(m_change);
+            delegate_array new_targets = xlang::impl::make_event_array<Delegate>((!m_targets) ? 1 : m_targets->size() + 1);
+
+            if (m_targets)
+            {
+                std::copy_n(m_targets->begin(), m_targets->size(), new_targets->begin());
+            }
+
+            new_targets->back() = delegate;
+            std::lock_guard const swap_guard(m_swap);
+            m_targets = std::move(new_targets);
+        }
+
+        template <typename... Arg>
+        void operator()(Arg const&... args)
+        {
+            delegate_array temp_targets;
+
+            {
+                std::lock_guard const swap_guard(m_swap);
+                temp_targets = m_targets;
+            }
+
+            if (temp_targets)
+            {
+                for (Delegate const& element : *temp_targets)
+                {
+                    element(args...);
+                }
+            }
+        }
+
+    private:
+
+        delegate_array m_targets;
+        std::mutex m_swap;
+        std::mutex m_change;
+    };
+
+    // Raises the event s.iterations() times in total, split across thread_count threads that all
+    // start together.
+    template <typename Event>
+    void raise(state& s, uint32_t const thread_count)
+    {
+        Event source;
+        source.add(handler([](int value) { do_not_optimize(value); }));
+
+        uint64_t const per_thread = std::max<uint64_t>(s.iterations() / thread_count, 1);
+        std::atomic<uint32_t> ready{};
+        std::atomic<bool> start{};
+
+        s.pause();
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([&]
+            {
+                ++ready;
+
+                while (!start)
+                {
+                    std::this_thread::yield();
+                }
+
+                for (uint64_t n = 0; n < per_thread; ++n)
+                {
+                    source(static_cast<int>(n));
+                }
+            });
+        }
+
+        while (ready != thread_count)
+        {
+            std::this_thread::yield();
+        }
+
+        s.resume();
+        start = true;
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    [[maybe_unused]] bool const registered = []
+    {
+        for (uint32_t const thread_count : { 1u, 4u, 16u })
+        {
+            auto const suffix = std::to_string(thread_count) + "_threads";
+            add("event/raise/lock_free/" + suffix, [thread_count](state& s) { raise<xlang::event<handler>>(s, thread_count); });
+            add("event/raise/locked/" + suffix, [thread_count](state& s) { raise<locked_event<handler>>(s, thread_count); });
+        }
+
+        return true;
+    }();
+}
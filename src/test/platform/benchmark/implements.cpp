@@ -0,0 +1,91 @@
+#include "benchmark.h"
+
+#include <xlang/base.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace xlang::benchmark;
+
+namespace
+{
+    using xlang::Windows::Foundation::IXlangObject;
+
+    struct tagged_object : xlang::implements<tagged_object, IXlangObject>
+    {
+    };
+
+    struct inline_object : xlang::implements<inline_object, IXlangObject, xlang::inline_weak_ref>
+    {
+    };
+
+    // Calls AddRef and Release s.iterations() times in total, split across thread_count threads that
+    // all start together. With a weak reference outstanding, a default implementation counts its
+    // references through a separately allocated control block. One marked with inline_weak_ref keeps
+    // counting in place.
+    template <typename Object>
+    void churn(state& s, uint32_t const thread_count, bool const with_weak_ref)
+    {
+        auto object = xlang::make_self<Object>();
+        xlang::weak_ref<Object> weak;
+
+        if (with_weak_ref)
+        {
+            weak = object->get_weak();
+        }
+
+        auto unknown = static_cast<xlang::impl::unknown_abi*>(xlang::get_abi(object.template as<IXlangObject>()));
+        uint64_t const per_thread = std::max<uint64_t>(s.iterations() / thread_count, 1);
+        std::atomic<uint32_t> ready{};
+        std::atomic<bool> start{};
+
+        s.pause();
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([&]
+            {
+                ++ready;
+
+                while (!start)
+                {
+                    std::this_thread::yield();
+                }
+
+                for (uint64_t n = 0; n < per_thread; ++n)
+                {
+                    do_not_optimize(unknown->AddRef());
+                    do_not_optimize(unknown->Release());
+                }
+            });
+        }
+
+        while (ready != thread_count)
+        {
+            std::this_thread::yield();
+        }
+
+        s.resume();
+        start = true;
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    [[maybe_unused]] bool const registered = []
+    {
+        for (uint32_t const thread_count : { 1u, 4u })
+        {
+            auto const suffix = std::to_string(thread_count) + "_threads";
+            add("implements/refcount/default/" + suffix, [thread_count](state& s) { churn<tagged_object>(s, thread_count, false); });
+            add("implements/refcount/default_with_weak_ref/" + suffix, [thread_count](state& s) { churn<tagged_object>(s, thread_count, true); });
+            add("implements/refcount/inline_weak_ref/" + suffix, [thread_count](state& s) { churn<inline_object>(s, thread_count, false); });
+            add("implements/refcount/inline_weak_ref_with_weak_ref/" + suffix, [thread_count](state& s) { churn<inline_object>(s, thread_count, true); });
+        }
+
+        return true;
+    }();
+}
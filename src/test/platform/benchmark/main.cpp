@@ -0,0 +1,212 @@
+#include "benchmark.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace xlang::benchmark;
+
+namespace
+{
+    struct settings
+    {
+        std::string filter;
+        std::string output;
+        double min_time{ 0.1 };
+        uint32_t repetitions{ 5 };
+    };
+
+    struct result
+    {
+        std::string name;
+        uint64_t iterations{};
+        double ns_per_op{};
+        double min_ns_per_op{};
+        std::map<std::string, double> counters;
+    };
+
+    void print_usage()
+    {
+        std::cerr << "Usage: benchmark_platform [--filter <substring>] [--min-time <seconds>] [--repetitions <count>] [--out <file.json>]\n";
+    }
+
+    bool parse_arguments(int argc, char** argv, settings& values)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view const arg{ argv[i] };
+            if (i + 1 >= argc)
+            {
+                return false;
+            }
+
+            if (arg == "--filter")
+            {
+                values.filter = argv[++i];
+            }
+            else if (arg == "--min-time")
+            {
+                values.min_time = std::strtod(argv[++i], nullptr);
+            }
+            else if (arg == "--repetitions")
+            {
+                std::string_view const value{ argv[++i] };
+                auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), values.repetitions);
+                if (error != std::errc{} || end != value.data() + value.size() || values.repetitions == 0)
+                {
+                    return false;
+                }
+            }
+            else if (arg == "--out")
+            {
+                values.output = argv[++i];
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double run_once(registration const& benchmark, uint64_t iterations, std::map<std::string, double>& counters)
+    {
+        state current{ iterations };
+        auto const start = std::chrono::steady_clock::now();
+        benchmark.body(current);
+        auto const elapsed = std::chrono::steady_clock::now() - start - current.excluded();
+        counters = current.counters();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    result run(registration const& benchmark, settings const& values)
+    {
+        result current;
+        current.name = benchmark.name;
+
+        // Grow the iteration count until a single run takes at least the minimum time.
+        double const min_ns = values.min_time * 1e9;
+        uint64_t iterations = 1;
+        double elapsed = run_once(benchmark, iterations, current.counters);
+        while (elapsed < min_ns && iterations < (1ull << 40))
+        {
+            double const scale = elapsed > 0 ? std::min(10.0, std::max(2.0, 1.4 * min_ns / elapsed)) : 10.0;
+            iterations = static_cast<uint64_t>(static_cast<double>(iterations) * scale);
+            elapsed = run_once(benchmark, iterations, current.counters);
+        }
+
+        std::vector<double> samples{ elapsed / static_cast<double>(iterations) };
+        while (samples.size() < values.repetitions)
+        {
+            samples.push_back(run_once(benchmark, iterations, current.counters) / static_cast<double>(iterations));
+        }
+
+        std::sort(samples.begin(), samples.end());
+        current.iterations = iterations;
+        current.ns_per_op = samples[samples.size() / 2];
+        current.min_ns_per_op = samples.front();
+        return current;
+    }
+
+    void write_json_string(std::ostream& out, std::string_view value)
+    {
+        out << '"';
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out << '\\';
+            }
+            out << c;
+        }
+        out << '"';
+    }
+
+    void write_json(std::ostream& out, std::vector<result> const& results, settings const& values)
+    {
+        out << "{\n  \"context\": {\n";
+        out << "    \"platform\": \"" << (XLANG_PLATFORM_WINDOWS ? "windows" : "posix") << "\",\n";
+#ifdef _DEBUG
+        out << "    \"build_type\": \"debug\",\n";
+#else
+        out << "    \"build_type\": \"release\",\n";
+#endif
+        out << "    \"min_time\": " << values.min_time << ",\n";
+        out << "    \"repetitions\": " << values.repetitions << "\n";
+        out << "  },\n  \"benchmarks\": [";
+
+        bool first = true;
+        for (auto const& current : results)
+        {
+            out << (first ? "\n" : ",\n") << "    {\n      \"name\": ";
+            write_json_string(out, current.name);
+            out << ",\n      \"iterations\": " << current.iterations;
+            out << ",\n      \"ns_per_op\": " << current.ns_per_op;
+            out << ",\n      \"min_ns_per_op\": " << current.min_ns_per_op;
+            if (!current.counters.empty())
+            {
+                out << ",\n      \"counters\": {";
+                bool first_counter = true;
+                for (auto const& [name, value] : current.counters)
+                {
+                    out << (first_counter ? " " : ", ");
+                    write_json_string(out, name);
+                    out << ": " << value;
+                    first_counter = false;
+                }
+                out << " }";
+            }
+            out << "\n    }";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    settings values;
+    if (!parse_arguments(argc, argv, values))
+    {
+        print_usage();
+        return 1;
+    }
+
+    auto benchmarks = registry();
+    std::sort(benchmarks.begin(), benchmarks.end(), [](auto const& left, auto const& right)
+    {
+        return left.name < right.name;
+    });
+
+    std::vector<result> results;
+    for (auto const& benchmark : benchmarks)
+    {
+        if (!values.filter.empty() && benchmark.name.find(values.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        results.push_back(run(benchmark, values));
+        auto const& current = results.back();
+        std::fprintf(stderr, "%-56s %12.1f ns/op %14llu iterations\n",
+            current.name.c_str(), current.ns_per_op, static_cast<unsigned long long>(current.iterations));
+    }
+
+    if (values.output.empty())
+    {
+        write_json(std::cout, results, values);
+    }
+    else
+    {
+        std::ofstream file{ values.output };
+        write_json(file, results, values);
+        if (!file)
+        {
+            std::cerr << "Failed to write " << values.output << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "benchmark.h"
+
+using namespace xlang::benchmark;
+
+namespace
+{
+    template <typename char_type>
+    std::string benchmark_name(std::string_view operation, uint32_t length)
+    {
+        std::string name{ "string/" };
+        name += operation;
+        name += '/';
+        name += encoding_name<char_type>;
+        name += '/';
+        name += std::to_string(length);
+        return name;
+    }
+
+    // Reports the heap allocations the PAL made for string storage, per created string.
+    struct allocation_counter
+    {
+        allocation_counter() noexcept
+        {
+            xlang_get_string_statistics(&m_start);
+        }
+
+        void report(state& s, uint64_t strings) const
+        {
+            xlang_string_statistics end{};
+            xlang_get_string_statistics(&end);
+            s.counter("allocations_per_string", static_cast<double>(end.string_allocations - m_start.string_allocations) / static_cast<double>(strings));
+        }
+
+    private:
+        xlang_string_statistics m_start{};
+    };
+
+    template <typename char_type>
+    void create_delete(state& s, std::basic_string<char_type> const& source)
+    {
+        auto const length = static_cast<uint32_t>(source.size());
+        allocation_counter allocations;
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            xlang_string str{};
+            static_cast<void>(create_string(source.data(), length, &str));
+            do_not_optimize(str);
+            xlang_delete_string(str);
+        }
+        allocations.report(s, s.iterations());
+    }
+
+    // Keeps a working set of strings alive before deleting them, as when building a list of
+    // property names.
+    template <typename char_type>
+    void create_hold_delete(state& s, std::basic_string<char_type> const& source)
+    {
+        constexpr uint64_t held_count = 32;
+        xlang_string strings[held_count]{};
+        auto const length = static_cast<uint32_t>(source.size());
+        allocation_counter allocations;
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            for (auto& str : strings)
+            {
+                static_cast<void>(create_string(source.data(), length, &str));
+            }
+            do_not_optimize(strings);
+            for (auto str : strings)
+            {
+                xlang_delete_string(str);
+            }
+        }
+        allocations.report(s, s.iterations() * held_count);
+    }
+
+    template <typename char_type>
+    void duplicate_delete(state& s, std::basic_string<char_type> const& source)
+    {
+        xlang_string str{};
+        static_cast<void>(create_string(source.data(), static_cast<uint32_t>(source.size()), &str));
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            xlang_string copy{};
+            static_cast<void>(xlang_duplicate_string(str, &copy));
+            do_not_optimize(copy);
+            xlang_delete_string(copy);
+        }
+        xlang_delete_string(str);
+    }
+
+    template <typename char_type>
+    void create_reference(state& s, std::basic_string<char_type> const& source)
+    {
+        auto const length = static_cast<uint32_t>(source.size());
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            xlang_string_header header{};
+            xlang_string str{};
+            static_cast<void>(create_string_reference(source.data(), length, &header, &str));
+            do_not_optimize(str);
+            xlang_delete_string(str);
+        }
+    }
+
+    // Requests the buffer in the string's own encoding, which never converts.
+    template <typename char_type>
+    void raw_buffer_native(state& s, std::basic_string<char_type> const& source)
+    {
+        xlang_string str{};
+        static_cast<void>(create_string(source.data(), static_cast<uint32_t>(source.size()), &str));
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            char_type const* buffer{};
+            uint32_t length{};
+            static_cast<void>(get_string_raw_buffer(str, &buffer, &length));
+            do_not_optimize(buffer);
+        }
+        xlang_delete_string(str);
+    }
+
+    // Requests the other encoding once the alternate form has already been cached on the string.
+    template <typename char_type>
+    void raw_buffer_cached(state& s, std::basic_string<char_type> const& source)
+    {
+        using other_type = std::conditional_t<std::is_same_v<char_type, xlang_char8>, char16_t, xlang_char8>;
+        xlang_string str{};
+        static_cast<void>(create_string(source.data(), static_cast<uint32_t>(source.size()), &str));
+        other_type const* buffer{};
+        uint32_t length{};
+        static_cast<void>(get_string_raw_buffer(str, &buffer, &length));
+        for (uint64_t i = 0; i < s.iterations(); ++i)
+        {
+            static_cast<void>(get_string_raw_buffer(str, &buffer, &length));
+            do_not_optimize(buffer);
+        }
+        xlang_delete_string(str);
+    }
+
+    // Requests the other encoding from fresh strings, so every call converts and caches the result.
+    // Creating and deleting the strings is excluded from the measurement.
+    template <typename char_type>
+    void raw_buffer_uncached(state& s, std::basic_string<char_type> const& source)
+    {
+        using other_type = std::conditional_t<std::is_same_v<char_type, xlang_char8>, char16_t, xlang_char8>;
+        constexpr uint64_t batch_size = 256;
+        xlang_string strings[batch_size]{};
+        auto const length = static_cast<uint32_t>(source.size());
+
+        for (uint64_t done = 0; done < s.iterations(); done += batch_size)
+        {
+            uint64_t const count = std::min(batch_size, s.iterations() - done);
+
+            s.pause();
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                static_cast<void>(create_string(source.data(), length, &strings[i]));
+            }
+            s.resume();
+
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                other_type const* buffer{};
+                uint32_t buffer_length{};
+                static_cast<void>(get_string_raw_buffer(strings[i], &buffer, &buffer_length));
+                do_not_optimize(buffer);
+            }
+
+            s.pause();
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                xlang_delete_string(strings[i]);
+            }
+            s.resume();
+        }
+    }
+
+    template <typename char_type>
+    void add_string_benchmarks()
+    {
+        for (uint32_t const length : string_lengths)
+        {
+            auto source = make_ascii_string<char_type>(length);
+            add(benchmark_name<char_type>("create_delete", length), [source](state& s) { create_delete(s, source); });
+            add(benchmark_name<char_type>("create_hold_delete", length), [source](state& s) { create_hold_delete(s, source); });
+            add(benchmark_name<char_type>("duplicate_delete", length), [source](state& s) { duplicate_delete(s, source); });
+            add(benchmark_name<char_type>("create_reference", length), [source](state& s) { create_reference(s, source); });
+            add(benchmark_name<char_type>("raw_buffer_native", length), [source](state& s) { raw_buffer_native(s, source); });
+            add(benchmark_name<char_type>("raw_buffer_cached", length), [source](state& s) { raw_buffer_cached(s, source); });
+            add(benchmark_name<char_type>("raw_buffer_uncached", length), [source](state& s) { raw_buffer_uncached(s, source); });
+        }
+    }
+
+    [[maybe_unused]] bool const registered = []
+    {
+        add_string_benchmarks<xlang_char8>();
+        add_string_benchmarks<char16_t>();
+        return true;
+    }();
+}
@@ -211,4 +211,60 @@ TEST_CASE("Error origination with all parameters")
     propagated_error = nullptr;
     REQUIRE(result->Release() == 0);
     result = nullptr;
-}
\ No newline at end of file
+}
+
+TEST_CASE("Error origination in lightweight mode")
+{
+    REQUIRE(xlang_set_error_mode(xlang_error_mode::lightweight) == xlang_error_mode::full);
+
+    INFO("Code-only errors share an immortal error info");
+    xlang_error_info* result = xlang_originate_error(xlang_result::bounds);
+    REQUIRE(result != nullptr);
+    xlang_error_info* result2 = xlang_originate_error(xlang_result::bounds);
+    REQUIRE(result == result2);
+    verify_error_info(result, xlang_result::bounds);
+
+    INFO("Propagation is not recorded on shared error infos");
+    result->PropagateError(nullptr, nullptr, nullptr, nullptr);
+    verify_error_info(result, xlang_result::bounds);
+
+    REQUIRE(result2->Release() != 0);
+    REQUIRE(result->Release() != 0);
+
+    INFO("Every error code has its own instance");
+    xlang_error_info* type_load = xlang_originate_error(xlang_result::type_load);
+    verify_error_info(type_load, xlang_result::type_load);
+    REQUIRE(type_load->Release() != 0);
+
+    INFO("Errors with a message are still allocated");
+    basic_string_view<xlang_char8> str = "This is an error";
+    xlang_string message{};
+    REQUIRE(xlang_create_string_utf8(str.data(), static_cast<uint32_t>(str.size()), &message) == nullptr);
+    result = xlang_originate_error(xlang_result::bounds, message);
+    verify_error_info(result, xlang_result::bounds, message);
+    REQUIRE(result->Release() == 0);
+    xlang_delete_string(message);
+
+    REQUIRE(xlang_set_error_mode(xlang_error_mode::full) == xlang_error_mode::lightweight);
+}
+
+TEST_CASE("Recycled error infos don't retain state")
+{
+    basic_string_view<xlang_char8> str = "This is an error";
+    xlang_string message{};
+    REQUIRE(xlang_create_string_utf8(str.data(), static_cast<uint32_t>(str.size()), &message) == nullptr);
+
+    for (int i = 0; i < 64; ++i)
+    {
+        xlang_error_info* result = xlang_originate_error(xlang_result::invalid_arg, message);
+        result->PropagateError(message, nullptr, nullptr, nullptr);
+        verify_error_info(result, xlang_result::invalid_arg, message, nullptr, nullptr, nullptr, nullptr, true);
+        REQUIRE(result->Release() == 0);
+
+        result = xlang_originate_error(xlang_result::fail);
+        verify_error_info(result, xlang_result::fail);
+        REQUIRE(result->Release() == 0);
+    }
+
+    xlang_delete_string(message);
+}
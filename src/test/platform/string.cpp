@@ -1,6 +1,10 @@
 #include "pch.h"
 #include "string_helpers.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace std;
 using namespace std::string_view_literals;
 
@@ -260,6 +264,90 @@ TEST_CASE("Simple UTF-16 strings")
     simple_string<char16_t>();
 }
 
+template <typename char_type>
+void batch_strings()
+{
+    using other_type = typename alternate_type<char_type>::type;
+    auto const& test_strings = valid_strings<char_type>::value;
+    constexpr uint32_t count = static_cast<uint32_t>(std::size(valid_strings<char_type>::value));
+
+    char_type const* sources[count]{};
+    uint32_t lengths[count]{};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sources[i] = test_strings[i].data();
+        lengths[i] = static_cast<uint32_t>(test_strings[i].size());
+    }
+
+    xlang_string strings[count]{};
+    xlang_error_info* result{};
+
+    {
+        INFO("Create a batch of strings");
+        result = xlang_create_strings<char_type>(count, sources, lengths, strings);
+        REQUIRE(result == nullptr);
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        INFO("Each string matches its source, and empty strings are null");
+        REQUIRE((strings[i] == nullptr) == test_strings[i].empty());
+        char_type const* buffer{};
+        uint32_t length{};
+        result = xlang_get_string_raw_buffer<char_type>(strings[i], &buffer, &length);
+        REQUIRE(result == nullptr);
+        REQUIRE(test_strings[i] == basic_string_view<char_type>{buffer, length});
+    }
+
+    xlang_string str{};
+    {
+        INFO("A string from a batch can be duplicated and converted");
+        result = xlang_duplicate_string(strings[count - 1], &str);
+        REQUIRE(result == nullptr);
+        REQUIRE(str == strings[count - 1]);
+
+        other_type const* buffer{};
+        uint32_t length{};
+        result = xlang_get_string_raw_buffer<other_type>(str, &buffer, &length);
+        REQUIRE(result == nullptr);
+        REQUIRE(valid_strings<other_type>::value[count - 1] == basic_string_view<other_type>{buffer, length});
+    }
+
+    {
+        INFO("The duplicate outlives the rest of the batch");
+        xlang_delete_strings(count, strings);
+
+        char_type const* buffer{};
+        uint32_t length{};
+        result = xlang_get_string_raw_buffer<char_type>(str, &buffer, &length);
+        REQUIRE(result == nullptr);
+        REQUIRE(test_strings[count - 1] == basic_string_view<char_type>{buffer, length});
+        xlang_delete_string(str);
+    }
+
+    {
+        INFO("Null sources with a non-zero length are rejected");
+        sources[count - 1] = nullptr;
+        result = xlang_create_strings<char_type>(count, sources, lengths, strings);
+        REQUIRE(result != nullptr);
+        xlang_result error_code{};
+        result->GetError(&error_code);
+        REQUIRE(error_code == xlang_result::pointer);
+        REQUIRE(result->Release() == 0);
+        REQUIRE(std::all_of(std::begin(strings), std::end(strings), [](xlang_string value) { return value == nullptr; }));
+    }
+}
+
+TEST_CASE("Batch UTF-8 strings")
+{
+    batch_strings<xlang_char8>();
+}
+
+TEST_CASE("Batch UTF-16 strings")
+{
+    batch_strings<char16_t>();
+}
+
 template <typename char_type>
 void simple_string_reference()
 {
@@ -508,3 +596,204 @@ TEST_CASE("Convert UTF-16 string reference")
 {
     convert_string_reference<char16_t>();
 }
+
+template <typename char_type>
+void encoded_string()
+{
+    using other_type = typename alternate_type<char_type>::type;
+    constexpr auto both = xlang_string_encoding::utf8 | xlang_string_encoding::utf16;
+    for (size_t i = 0; i < std::size(valid_strings<char_type>::value); ++i)
+    {
+        auto const test_string = valid_strings<char_type>::value[i];
+        xlang_error_info* result{};
+        xlang_string str{};
+        {
+            INFO("Create a string with both encodings");
+            result = xlang_create_string_encoded<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), both, &str);
+            REQUIRE(result == nullptr);
+            REQUIRE(xlang_get_string_encoding(str) == both);
+        }
+
+        {
+            INFO("The alternate encoding is already available");
+            other_type const* buffer{};
+            uint32_t length{};
+            result = xlang_get_string_raw_buffer<other_type>(str, &buffer, &length);
+            REQUIRE(result == nullptr);
+            REQUIRE(valid_strings<other_type>::value[i] == basic_string_view<other_type>{buffer, length});
+        }
+
+        xlang_delete_string(str);
+    }
+
+    {
+        INFO("The source encoding is required");
+        auto const test_string = valid_strings<char_type>::value[2];
+        xlang_string str{};
+        xlang_error_info* result = xlang_create_string_encoded<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), encoding<other_type>::value, &str);
+        REQUIRE(result != nullptr);
+        REQUIRE(str == nullptr);
+        REQUIRE(result->Release() == 0);
+    }
+
+    for (auto const& test_string : invalid_strings<char_type>::value)
+    {
+        INFO("Strings that can't be converted fail to create");
+        xlang_string str{};
+        xlang_error_info* result = xlang_create_string_encoded<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), both, &str);
+        REQUIRE(result != nullptr);
+        REQUIRE(str == nullptr);
+        result->Release();
+    }
+}
+
+TEST_CASE("Encoded UTF-8 string")
+{
+    encoded_string<xlang_char8>();
+}
+
+TEST_CASE("Encoded UTF-16 string")
+{
+    encoded_string<char16_t>();
+}
+
+template <typename char_type>
+void concurrent_convert_string()
+{
+    using other_type = typename alternate_type<char_type>::type;
+    auto const test_string = valid_strings<char_type>::value[2];
+    constexpr size_t thread_count = 8;
+    constexpr size_t string_count = 64;
+
+    xlang_string_statistics before{};
+    xlang_get_string_statistics(&before);
+
+    for (size_t i = 0; i < string_count; ++i)
+    {
+        xlang_string str{};
+        REQUIRE(xlang_create_string<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), &str) == nullptr);
+
+        std::atomic<size_t> ready{};
+        other_type const* buffers[thread_count]{};
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                ++ready;
+                while (ready.load() != thread_count)
+                {
+                }
+                uint32_t length{};
+                if (xlang_get_string_raw_buffer<other_type>(str, &buffers[t], &length) != nullptr)
+                {
+                    buffers[t] = nullptr;
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        INFO("Every thread observes the same converted buffer");
+        REQUIRE(buffers[0] != nullptr);
+        REQUIRE(std::all_of(std::begin(buffers), std::end(buffers), [&](other_type const* buffer) { return buffer == buffers[0]; }));
+        xlang_delete_string(str);
+    }
+
+    xlang_string_statistics after{};
+    xlang_get_string_statistics(&after);
+
+    INFO("Each string was converted exactly once");
+    REQUIRE(after.alternate_conversions - before.alternate_conversions == string_count);
+}
+
+TEST_CASE("Concurrent UTF-8 string conversion")
+{
+    concurrent_convert_string<xlang_char8>();
+}
+
+TEST_CASE("Concurrent UTF-16 string conversion")
+{
+    concurrent_convert_string<char16_t>();
+}
+
+template <typename char_type>
+void small_string()
+{
+    using other_type = typename alternate_type<char_type>::type;
+    xlang_string_statistics before{};
+    xlang_get_string_statistics(&before);
+
+    {
+        INFO("Single ASCII character strings share one immortal instance");
+        char_type const source[] = { 'x', 0 };
+        xlang_string first{};
+        xlang_string second{};
+        REQUIRE(xlang_create_string<char_type>(source, 1, &first) == nullptr);
+        REQUIRE(xlang_create_string<char_type>(source, 1, &second) == nullptr);
+        REQUIRE(first == second);
+
+        xlang_string copy{};
+        REQUIRE(xlang_duplicate_string(first, &copy) == nullptr);
+        xlang_delete_string(first);
+        xlang_delete_string(second);
+
+        other_type const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer<other_type>(copy, &buffer, &length) == nullptr);
+        REQUIRE(length == 1);
+        REQUIRE(buffer[0] == 'x');
+        REQUIRE(buffer[1] == 0);
+        xlang_delete_string(copy);
+    }
+
+    {
+        INFO("Short strings reuse blocks cached on the thread");
+        char_type const source[] = { 'N', 'a', 'm', 'e', 0 };
+        basic_string_view<char_type> const test_string{ source };
+        for (int i = 0; i < 100; ++i)
+        {
+            xlang_string str{};
+            REQUIRE(xlang_create_string<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), &str) == nullptr);
+            char_type const* buffer{};
+            uint32_t length{};
+            REQUIRE(xlang_get_string_raw_buffer<char_type>(str, &buffer, &length) == nullptr);
+            REQUIRE(test_string == basic_string_view<char_type>{ buffer, length });
+            xlang_delete_string(str);
+        }
+    }
+
+    xlang_string_statistics after{};
+    xlang_get_string_statistics(&after);
+    REQUIRE(after.string_allocations - before.string_allocations <= 1);
+
+    {
+        INFO("Short strings can be released on another thread");
+        char_type const source[] = { 'N', 'a', 'm', 'e', 0 };
+        basic_string_view<char_type> const test_string{ source };
+        xlang_string strings[16]{};
+        for (auto& str : strings)
+        {
+            REQUIRE(xlang_create_string<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), &str) == nullptr);
+        }
+        std::thread([&]
+        {
+            for (auto str : strings)
+            {
+                xlang_delete_string(str);
+            }
+        }).join();
+    }
+}
+
+TEST_CASE("Small UTF-8 strings")
+{
+    small_string<xlang_char8>();
+}
+
+TEST_CASE("Small UTF-16 strings")
+{
+    small_string<char16_t>();
+}
@@ -16,6 +16,34 @@ auto xlang_create_string(char_type const* source, uint32_t length, xlang_string*
     }
 }
 
+template <typename char_type>
+auto xlang_create_string_encoded(char_type const* source, uint32_t length, xlang_string_encoding encodings, xlang_string* str)
+{
+    static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+    if constexpr (std::is_same_v<char_type, xlang_char8>)
+    {
+        return xlang_create_string_encoded_utf8(source, length, encodings, str);
+    }
+    else
+    {
+        return xlang_create_string_encoded_utf16(source, length, encodings, str);
+    }
+}
+
+template <typename char_type>
+auto xlang_create_strings(uint32_t count, char_type const* const* sources, uint32_t const* lengths, xlang_string* strings)
+{
+    static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+    if constexpr (std::is_same_v<char_type, xlang_char8>)
+    {
+        return xlang_create_strings_utf8(count, sources, lengths, strings);
+    }
+    else
+    {
+        return xlang_create_strings_utf16(count, sources, lengths, strings);
+    }
+}
+
 template <typename char_type>
 auto xlang_create_string_reference(char_type const* source, uint32_t length, xlang_string_header* header, xlang_string* str)
 {
@@ -30,6 +30,9 @@ static constexpr option options[]
     { "output", 0, 1, "<path>", "Location of generated headers" },
     { "include", 0, option::no_max, "<prefix>", "One or more prefixes to include in input" },
     { "exclude", 0, option::no_max, "<prefix>", "One or more prefixes to exclude from input" },
+    { "scan-depth", 0, 1, "<n>", "Depth of subfolders to scan in input folders (defaults to unlimited)" },
+    { "scan-match", 0, option::no_max, "<glob>", "One or more file name patterns to scan for in input folders" },
+    { "scan-skip", 0, option::no_max, "<glob>", "One or more file or folder name patterns to skip in input folders" },
     { "verbose", 0, 0, {}, "Show detailed progress information" },
     { "ns-prefix", 0, 1, "<always|optional|never>", "Sets policy for prefixing type names with 'ABI' namespace (default: never)" },
     { "enum-class", 0, 0, {}, "Use 'MIDL_ENUM', rather than 'enum'" },
@@ -130,8 +133,9 @@ int main(int const argc, char** argv)
             config.ns_prefix_state = ns_prefix::never;
         }
 
-        auto inputFiles = args.files("input");
-        auto referenceFiles = args.files("reference");
+        auto const search = args.search();
+        auto inputFiles = args.files("input", search);
+        auto referenceFiles = args.files("reference", search);
 
         if (config.verbose)
         {
@@ -154,18 +158,24 @@ int main(int const argc, char** argv)
         filesToRead.insert(filesToRead.end(), inputFiles.begin(), inputFiles.end());
         filesToRead.insert(filesToRead.end(), referenceFiles.begin(), referenceFiles.end());
 
-        cache c{ filesToRead };
-        metadata_cache mdCache{ c };
+        auto shared = shared_cache::get(filesToRead);
+        cache const& c = shared->get();
+        metadata_cache const& mdCache = shared->extension<metadata_cache>();
 
         auto include = args.values("include");
         if (include.empty() && !referenceFiles.empty())
         {
+            // The shared cache opens files by their canonical path, so compare inputs the same way.
+            std::vector<std::string> canonicalInputs;
+            canonicalInputs.reserve(inputFiles.size());
+            for (auto const& file : inputFiles)
+            {
+                canonicalInputs.push_back(canonical(file).string());
+            }
+
             for (auto const& db : c.databases())
             {
-                if (std::find_if(inputFiles.begin(), inputFiles.end(), [&](auto const& file)
-                    {
-                        return db.path() == file;
-                    }) != inputFiles.end())
+                if (std::find(canonicalInputs.begin(), canonicalInputs.end(), db.path()) != canonicalInputs.end())
                 {
                     for (auto const& type : db.TypeDef)
                     {
@@ -261,6 +271,11 @@ int main(int const argc, char** argv)
 
         if (config.verbose)
         {
+            auto report = c.memory_report();
+            auto const abiReport = mdCache.memory_report();
+            report.structures.insert(report.structures.end(), abiReport.structures.begin(), abiReport.structures.end());
+            report.write(w);
+
             w.write("time: %ms\n", static_cast<std::int64_t>(duration_cast<milliseconds>((high_resolution_clock::now() - start)).count()));
         }
     }
@@ -612,7 +612,7 @@ metadata_type const& metadata_cache::find_dependent_type(init_state& state, Gene
 }
 
 template <typename T>
-static void merge_into(std::vector<T>& from, std::vector<std::reference_wrapper<T const>>& to)
+static void merge_into(std::vector<T> const& from, std::vector<std::reference_wrapper<T const>>& to)
 {
     std::vector<std::reference_wrapper<T const>> result;
     result.reserve(from.size() + to.size());
@@ -620,7 +620,7 @@ static void merge_into(std::vector<T>& from, std::vector<std::reference_wrapper<
     to.swap(result);
 }
 
-type_cache metadata_cache::compile_namespaces(std::initializer_list<std::string_view> targetNamespaces)
+type_cache metadata_cache::compile_namespaces(std::initializer_list<std::string_view> targetNamespaces) const
 {
     type_cache result{ this };
 
@@ -720,3 +720,28 @@ type_cache metadata_cache::compile_namespaces(std::initializer_list<std::string_
 
     return result;
 }
+
+xlang::meta::reader::memory_report metadata_cache::memory_report() const
+{
+    memory_usage nsUsage{ "abi namespaces" };
+    memory_usage definitions{ "abi definitions" };
+    memory_usage dependencies{ "abi dependencies" };
+    memory_usage typeTable{ "abi type table" };
+
+    nsUsage.nodes = node_bytes(namespaces);
+    for (auto const& [ns, nsCache] : namespaces)
+    {
+        definitions.vectors += vector_bytes(nsCache.enums) + vector_bytes(nsCache.structs) + vector_bytes(nsCache.delegates) +
+            vector_bytes(nsCache.interfaces) + vector_bytes(nsCache.classes) + vector_bytes(nsCache.contracts);
+        dependencies.nodes += node_bytes(nsCache.dependent_namespaces) + node_bytes(nsCache.generic_instantiations) +
+            node_bytes(nsCache.type_dependencies);
+    }
+
+    typeTable.nodes = node_bytes(m_typeTable);
+    for (auto const& [ns, table] : m_typeTable)
+    {
+        typeTable.nodes += node_bytes(table);
+    }
+
+    return { { nsUsage, definitions, dependencies, typeTable } };
+}
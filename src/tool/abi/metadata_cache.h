@@ -88,7 +88,11 @@ struct metadata_cache
 
     metadata_cache(xlang::meta::reader::cache const& c);
 
-    type_cache compile_namespaces(std::initializer_list<std::string_view> targetNamespaces);
+    type_cache compile_namespaces(std::initializer_list<std::string_view> targetNamespaces) const;
+
+    // Estimates the memory held by the namespace and type tables. Only the top level of each table is
+    // counted, not the members and functions held by the types themselves.
+    xlang::meta::reader::memory_report memory_report() const;
 
     metadata_type const* try_find(std::string_view typeNamespace, std::string_view typeName) const
     {
@@ -24,6 +24,7 @@ namespace xlang
         w.write(strings::base_array);
         w.write(strings::base_weak_ref);
         w.write(strings::base_error, XLANG_VERSION_STRING);
+        w.write(strings::base_allocator);
         w.write(strings::base_delegate);
         w.write(strings::base_events);
         w.write(strings::base_activation);
@@ -39,6 +40,32 @@ namespace xlang
         w.flush_to_file(settings.output_folder + "xlang/base.h");
     }
 
+    static void write_executor_h()
+    {
+        writer w;
+        write_preamble(w);
+        write_open_file_guard(w, "EXECUTOR");
+
+        w.write(R"(
+#include "xlang/base.h"
+#include <deque>
+#include <system_error>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+)");
+
+        w.write(strings::base_executor);
+        w.write(strings::base_executor_resume);
+
+        write_close_file_guard(w);
+        w.flush_to_file(settings.output_folder + "xlang/executor.h");
+    }
+
     static void write_coroutine_h()
     {
         writer w;
@@ -48,6 +75,7 @@ namespace xlang
         w.write(R"(
 #include <experimental/coroutine>
 #include "xlang/Foundation.h"
+#include "xlang/executor.h"
 )");
 
         w.write(strings::base_coroutine);
@@ -64,12 +92,13 @@ namespace xlang
     {
         writer w;
         w.type_namespace = ns;
+        auto const structs = get_projected_structs(members);
 
         write_type_namespace(w, ns);
         w.write_each<write_enum>(members.enums);
         w.write_each<write_forward>(members.interfaces);
         w.write_each<write_forward>(members.classes);
-        w.write_each<write_forward>(members.structs);
+        w.write_each<write_forward>(structs);
         w.write_each<write_forward>(members.delegates);
         write_close_namespace(w);
         write_impl_namespace(w);
@@ -77,12 +106,12 @@ namespace xlang
         w.write_each<write_category>(members.interfaces, "interface_category");
         w.write_each<write_category>(members.classes, "class_category");
         w.write_each<write_category>(members.enums, "enum_category");
-        w.write_each<write_struct_category>(members.structs);
+        w.write_each<write_struct_category>(structs);
         w.write_each<write_category>(members.delegates, "delegate_category");
         w.write_each<write_name>(members.interfaces);
         w.write_each<write_name>(members.classes);
         w.write_each<write_name>(members.enums);
-        w.write_each<write_name>(members.structs);
+        w.write_each<write_name>(structs);
         w.write_each<write_name>(members.delegates);
         w.write_each<write_guid>(members.interfaces);
         w.write_each<write_guid>(members.delegates);
@@ -90,7 +119,7 @@ namespace xlang
         w.write_each<write_interface_abi>(members.interfaces);
         w.write_each<write_delegate_abi>(members.delegates);
         w.write_each<write_consume>(members.interfaces);
-        w.write_each<write_struct_abi>(members.structs);
+        w.write_each<write_struct_abi>(structs);
         write_close_namespace(w);
 
         write_close_file_guard(w);
@@ -138,7 +167,7 @@ namespace xlang
 
         write_type_namespace(w, ns);
         w.write_each<write_delegate>(members.delegates);
-        bool const promote = write_structs(w, members.structs);
+        bool const promote = write_structs(w, get_projected_structs(members));
         w.write_each<write_class>(members.classes);
         w.write_each<write_interface_override>(members.classes);
         write_close_namespace(w);
@@ -539,13 +539,31 @@ namespace xlang
         return false;
     }
 
+    // These structs are projected by hand in base.h. They are skipped when writing rather than
+    // removed from the cache, which may be shared with other generators.
+    static bool is_hand_projected(TypeDef const& type)
+    {
+        return type.TypeNamespace() == "Foundation" &&
+            (type.TypeName() == "DateTime" || type.TypeName() == "EventRegistrationToken" || type.TypeName() == "TimeSpan");
+    }
+
+    static std::vector<TypeDef> get_projected_structs(cache::namespace_members const& members)
+    {
+        std::vector<TypeDef> result;
+        std::copy_if(members.structs.begin(), members.structs.end(), std::back_inserter(result), [](auto&& type)
+        {
+            return !is_hand_projected(type);
+        });
+        return result;
+    }
+
     static bool has_projected_types(cache::namespace_members const& members)
     {
         return
             !members.interfaces.empty() ||
             !members.classes.empty() ||
             !members.enums.empty() ||
-            !members.structs.empty() ||
+            !get_projected_structs(members).empty() ||
             !members.delegates.empty();
     }
 }
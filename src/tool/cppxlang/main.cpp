@@ -28,6 +28,9 @@ namespace xlang
         { "pch", 0, 1, "<name>", "Specify name of precompiled header file (defaults to pch.h)" },
         { "include", 0, cmd::option::no_max, "<prefix>", "One or more prefixes to include in input" },
         { "exclude", 0, cmd::option::no_max, "<prefix>", "One or more prefixes to exclude from input" },
+        { "scan-depth", 0, 1, "<n>", "Depth of subfolders to scan in input folders (defaults to unlimited)" },
+        { "scan-match", 0, cmd::option::no_max, "<glob>", "One or more file name patterns to scan for in input folders" },
+        { "scan-skip", 0, cmd::option::no_max, "<glob>", "One or more file or folder name patterns to skip in input folders" },
         { "base", 0, 0, {}, "Generate base.h unconditionally" },
         { "optimize", 0, 0, {}, "Generate component projection with unified construction support" },
         { "help", 0, cmd::option::no_max, {}, "Show detailed help with examples" },
@@ -84,8 +87,9 @@ Where <spec> is one or more of:
 
         settings.verbose = args.exists("verbose");
 
-        settings.input = args.files("input", database::is_database);
-        settings.reference = args.files("reference", database::is_database);
+        auto const search = args.search();
+        settings.input = args.files("input", database::is_database, search);
+        settings.reference = args.files("reference", database::is_database, search);
 
         settings.component = args.exists("component");
         settings.base = args.exists("base");
@@ -172,6 +176,9 @@ Where <spec> is one or more of:
 
         for (auto file : settings.input)
         {
+            // The shared cache opens files by their canonical path.
+            file = canonical(file).string();
+
             auto db = std::find_if(c.databases().begin(), c.databases().end(), [&](auto&& db)
             {
                 return db.path() == file;
@@ -204,13 +211,6 @@ Where <spec> is one or more of:
 
     }
 
-    static void remove_foundation_types(cache& c)
-    {
-        c.remove_type("Foundation", "DateTime");
-        c.remove_type("Foundation", "EventRegistrationToken");
-        c.remove_type("Foundation", "TimeSpan");
-    }
-
     static int run(int const argc, char** argv)
     {
         int result{};
@@ -220,8 +220,8 @@ Where <spec> is one or more of:
         {
             auto start = get_start_time();
             process_args(argc, argv);
-            cache c{ get_files_to_cache() };
-            remove_foundation_types(c);
+            auto shared = shared_cache::get(get_files_to_cache());
+            cache const& c = shared->get();
             build_filters(c);
             settings.base = settings.base || (!settings.component && settings.projection_filter.empty());
 
@@ -255,7 +255,7 @@ Where <spec> is one or more of:
             {
                 group.add([&, &ns = ns, &members = members]
                 {
-                    if (!has_projected_types(members) || !settings.projection_filter.includes(members))
+                    if (!settings.projection_filter.includes(members) || !has_projected_types(members))
                     {
                         return;
                     }
@@ -272,6 +272,7 @@ Where <spec> is one or more of:
                 if (settings.base)
                 {
                     write_base_h();
+                    write_executor_h();
                     write_coroutine_h();
                 }
 
@@ -309,6 +310,7 @@ Where <spec> is one or more of:
 
             if (settings.verbose)
             {
+                c.memory_report().write(w);
                 w.write(" time:  %ms\n", get_elapsed_time(start));
             }
         }
@@ -13,28 +13,81 @@ namespace xlang
 
 namespace xlang::impl
 {
+    // The part of a factory cache entry that doesn't depend on the class. An entry joins the list of
+    // cached entries the first time it misses, so that the caches can be cleared and their counters
+    // reported. Hits are only counted while count_factory_cache_hits is on, because counting them makes
+    // every cached call write to memory shared by all threads.
+    struct factory_cache_entry_base
+    {
+        constexpr factory_cache_entry_base(std::basic_string_view<xlang_char8> const class_name, guid const& interface_id) noexcept :
+            m_class_name(class_name),
+            m_interface_id(interface_id)
+        {
+        }
+
+        std::atomic<void*> m_value{};
+        std::atomic<uint64_t> m_hits{};
+        std::atomic<uint32_t> m_misses{};
+        std::atomic<int64_t> m_resolution_time{};
+        std::basic_string_view<xlang_char8> const m_class_name;
+        guid const m_interface_id;
+        factory_cache_entry_base* m_next{};
+        bool m_registered{};
+    };
+
+    inline std::mutex g_factory_cache_lock;
+    inline factory_cache_entry_base* g_factory_cache_first{};
+    inline std::atomic<bool> g_count_factory_cache_hits{};
+
+    inline void register_factory_cache_entry(factory_cache_entry_base& entry)
+    {
+        std::lock_guard const guard(g_factory_cache_lock);
+
+        if (!entry.m_registered)
+        {
+            entry.m_registered = true;
+            entry.m_next = g_factory_cache_first;
+            g_factory_cache_first = &entry;
+        }
+    }
+
     template <typename Class, typename Interface>
-    struct factory_cache_entry
+    struct factory_cache_entry : factory_cache_entry_base
     {
+        constexpr factory_cache_entry() noexcept :
+            factory_cache_entry_base(name_of<Class>(), guid_of<Interface>())
+        {
+        }
+
         template <typename F>
         auto call(F&& callback)
         {
             void* value = m_value.load(std::memory_order_acquire);
             if (value)
             {
+                if (g_count_factory_cache_hits.load(std::memory_order_relaxed))
+                {
+                    m_hits.fetch_add(1, std::memory_order_relaxed);
+                }
+
                 return callback(*reinterpret_cast<com_ref<Interface> const*>(&value));
             }
 
+            if (m_misses.fetch_add(1, std::memory_order_relaxed) == 0)
+            {
+                register_factory_cache_entry(*this);
+            }
+
+            auto const start = std::chrono::steady_clock::now();
             auto object = get_activation_factory<Interface>(name_of<Class>());
+            m_resolution_time.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+
             if (m_value.compare_exchange_strong(value, get_abi(object), std::memory_order_acq_rel))
             {
                 value = detach_abi(object);
             }
             return callback(*reinterpret_cast<com_ref<Interface> const*>(&value));
         }
-
-    private:
-        std::atomic<void*> m_value{};
     };
 
     template <typename Class, typename Interface>
@@ -54,6 +107,70 @@ namespace xlang::impl
         return factory_storage<Class, Interface>::factory.call(callback);
     }
 
+    template <typename Class>
+    void preload_factory()
+    {
+        call_factory<Class>([](auto&&) {});
+    }
+
+    // Calls action(index) for each index below count on up to one thread per core, including the
+    // calling thread. The first exception is rethrown once every call has finished.
+    template <typename F>
+    void parallel_for_each_index(uint32_t const count, F const& action)
+    {
+        std::atomic<uint32_t> next{};
+        std::exception_ptr error;
+        std::mutex error_lock;
+
+        auto worker = [&]
+        {
+            for (uint32_t index; (index = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+            {
+                try
+                {
+                    action(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard const guard(error_lock);
+
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        uint32_t const thread_count = (std::min)(count, (std::max)(1u, std::thread::hardware_concurrency()));
+        std::vector<std::thread> threads;
+
+        for (uint32_t index = 1; index < thread_count; ++index)
+        {
+            try
+            {
+                threads.emplace_back(worker);
+            }
+            catch (...)
+            {
+                // The remaining work runs on the threads that did start.
+                break;
+            }
+        }
+
+        worker();
+
+        for (auto&& thread : threads)
+        {
+            thread.join();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
     template <typename Class, typename Interface = Windows::Foundation::IActivationFactory>
     impl::com_ref<Interface> try_get_activation_factory(xlang_error* exception = nullptr) noexcept
     {
@@ -120,6 +237,69 @@ namespace xlang
         });
     }
 
+    // Resolves and caches the activation factories of the classes in parallel, so that their first use
+    // doesn't pay for loading the modules that implement them. The first error is rethrown after the
+    // other factories have been resolved.
+    template <typename... Classes>
+    void preload_factories()
+    {
+        if constexpr (sizeof...(Classes) != 0)
+        {
+            static constexpr void(*preloaders[])() = { impl::preload_factory<Classes>... };
+            impl::parallel_for_each_index(sizeof...(Classes), [](uint32_t const index) { preloaders[index](); });
+        }
+    }
+
+    // Releases every cached activation factory, for example before the modules that implement them are
+    // unloaded. Factories are resolved again on their next use. No other thread may be using a cached
+    // factory at the time.
+    inline void clear_factory_caches()
+    {
+        std::lock_guard const guard(impl::g_factory_cache_lock);
+
+        for (auto entry = impl::g_factory_cache_first; entry; entry = entry->m_next)
+        {
+            if (void* value = entry->m_value.exchange(nullptr, std::memory_order_acq_rel))
+            {
+                static_cast<impl::unknown_abi*>(value)->Release();
+            }
+        }
+    }
+
+    struct factory_cache_statistics
+    {
+        std::basic_string_view<xlang_char8> class_name;
+        guid interface_id;
+        uint64_t hits; // Only counted while count_factory_cache_hits is on.
+        uint32_t misses;
+        std::chrono::nanoseconds resolution_time; // The total time spent resolving misses.
+    };
+
+    // Turns counting of factory cache hits on or off. It is off by default.
+    inline void count_factory_cache_hits(bool const enabled) noexcept
+    {
+        impl::g_count_factory_cache_hits.store(enabled, std::memory_order_relaxed);
+    }
+
+    // Reports the counters of each factory cache entry that has been used since the process started.
+    inline std::vector<factory_cache_statistics> get_factory_cache_statistics()
+    {
+        std::vector<factory_cache_statistics> result;
+        std::lock_guard const guard(impl::g_factory_cache_lock);
+
+        for (auto entry = impl::g_factory_cache_first; entry; entry = entry->m_next)
+        {
+            result.push_back({
+                entry->m_class_name,
+                entry->m_interface_id,
+                entry->m_hits.load(std::memory_order_relaxed),
+                entry->m_misses.load(std::memory_order_relaxed),
+                std::chrono::nanoseconds{ entry->m_resolution_time.load(std::memory_order_relaxed) } });
+        }
+
+        return result;
+    }
+
     template <typename Class, typename Interface = Windows::Foundation::IActivationFactory>
     auto try_get_activation_factory() noexcept
     {
@@ -148,4 +328,14 @@ namespace xlang
             }
         };
     }
+
+    // Resolves the activation factories of classes named at run time, for example by a manifest, in
+    // parallel. They aren't cached by the projection, but the modules that implement them are loaded.
+    inline void preload_factories(std::vector<hstring> const& class_names)
+    {
+        impl::parallel_for_each_index(static_cast<uint32_t>(class_names.size()), [&](uint32_t const index)
+        {
+            get_activation_factory(class_names[index]);
+        });
+    }
 }
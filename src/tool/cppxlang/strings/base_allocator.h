@@ -0,0 +1,204 @@
+
+namespace xlang
+{
+    // Replaces the allocator behind pooled implementations, delegates and event arrays, for example with
+    // an arena. allocate returns memory aligned for any fundamental type, or nullptr on failure. Install
+    // the hooks before creating any of these objects and leave them in place while any are alive, as
+    // each object is freed through the hooks installed at the time it is released. Debug builds assert
+    // that no such objects are alive when the hooks change.
+    struct allocation_hooks
+    {
+        void* (*allocate)(size_t size) noexcept;
+        void (*deallocate)(void* pointer, size_t size) noexcept;
+    };
+}
+
+namespace xlang::impl
+{
+    inline std::atomic<void* (*)(size_t) noexcept> g_allocate_hook{};
+    inline std::atomic<void (*)(void*, size_t) noexcept> g_deallocate_hook{};
+
+#ifdef _DEBUG
+    // The number of blocks handed out by pool_allocate and not yet returned to pool_deallocate.
+    inline std::atomic<size_t> g_pool_live_count{};
+#endif
+
+    // A bounded per-thread cache of freed blocks for each size class up to pool_max_size bytes. Blocks
+    // come from and return to the global heap, so an object may be released on a thread other than
+    // the one that created it. The cache is trivially constructible so that reaching it is a plain
+    // thread_local access. Its cleanup is registered the first time the thread caches a block.
+    inline constexpr size_t pool_granularity = 16;
+    inline constexpr size_t pool_size_classes = 16;
+    inline constexpr size_t pool_max_size = pool_granularity * pool_size_classes;
+    inline constexpr uint32_t pool_max_count = 64;
+
+    struct pool_cache
+    {
+        enum class cache_state : uint32_t
+        {
+            unused,
+            active,
+            destroyed, // Blocks freed after the thread's cleanup go straight back to the heap.
+        };
+
+        struct node
+        {
+            node* next;
+        };
+
+        node* heads[pool_size_classes];
+        uint32_t counts[pool_size_classes];
+        cache_state state;
+    };
+
+    inline thread_local pool_cache t_pool_cache{};
+
+    struct pool_cache_cleanup
+    {
+        ~pool_cache_cleanup() noexcept
+        {
+            auto& cache = t_pool_cache;
+            cache.state = pool_cache::cache_state::destroyed;
+
+            for (size_t index = 0; index < pool_size_classes; ++index)
+            {
+                while (cache.heads[index])
+                {
+                    auto next = cache.heads[index]->next;
+                    ::operator delete(cache.heads[index]);
+                    cache.heads[index] = next;
+                }
+
+                cache.counts[index] = 0;
+            }
+        }
+    };
+
+    inline void* pool_allocate_block(size_t const size)
+    {
+        XLANG_ASSERT(size != 0);
+
+        if (auto allocate = g_allocate_hook.load(std::memory_order_relaxed))
+        {
+            void* result = allocate(size);
+
+            if (!result)
+            {
+                throw std::bad_alloc();
+            }
+
+            return result;
+        }
+
+        size_t const index = (size - 1) / pool_granularity;
+
+        if (index >= pool_size_classes)
+        {
+            return ::operator new(size);
+        }
+
+        auto& cache = t_pool_cache;
+
+        if (auto block = cache.heads[index])
+        {
+            cache.heads[index] = block->next;
+            --cache.counts[index];
+            return block;
+        }
+
+        return ::operator new((index + 1) * pool_granularity);
+    }
+
+    inline void* pool_allocate(size_t const size)
+    {
+        void* const result = pool_allocate_block(size);
+#ifdef _DEBUG
+        ++g_pool_live_count;
+#endif
+        return result;
+    }
+
+    inline void pool_deallocate(void* const pointer, size_t const size) noexcept
+    {
+#ifdef _DEBUG
+        XLANG_ASSERT(g_pool_live_count != 0);
+        --g_pool_live_count;
+#endif
+
+        if (auto deallocate = g_deallocate_hook.load(std::memory_order_relaxed))
+        {
+            deallocate(pointer, size);
+            return;
+        }
+
+        size_t const index = (size - 1) / pool_granularity;
+
+        if (index >= pool_size_classes)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        auto& cache = t_pool_cache;
+
+        if (cache.state == pool_cache::cache_state::unused)
+        {
+            thread_local pool_cache_cleanup cleanup;
+            static_cast<void>(cleanup);
+            cache.state = pool_cache::cache_state::active;
+        }
+
+        if (cache.state != pool_cache::cache_state::active || cache.counts[index] == pool_max_count)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        cache.heads[index] = new (pointer) pool_cache::node{ cache.heads[index] };
+        ++cache.counts[index];
+    }
+
+    // Routes the allocations of a derived class through the pool. Over-aligned types bypass the pool
+    // and the hooks and use the global aligned allocation functions.
+    struct pooled_allocation
+    {
+        static void* operator new(size_t const size)
+        {
+            return pool_allocate(size);
+        }
+
+        static void operator delete(void* const pointer, size_t const size) noexcept
+        {
+            pool_deallocate(pointer, size);
+        }
+
+        static void* operator new(size_t const size, std::align_val_t const alignment)
+        {
+            return ::operator new(size, alignment);
+        }
+
+        static void operator delete(void* const pointer, size_t const size, std::align_val_t const alignment) noexcept
+        {
+            ::operator delete(pointer, size, alignment);
+        }
+    };
+}
+
+namespace xlang
+{
+    inline allocation_hooks get_allocation_hooks() noexcept
+    {
+        return { impl::g_allocate_hook.load(std::memory_order_relaxed), impl::g_deallocate_hook.load(std::memory_order_relaxed) };
+    }
+
+    inline void set_allocation_hooks(allocation_hooks const& hooks) noexcept
+    {
+        XLANG_ASSERT(!hooks.allocate == !hooks.deallocate);
+#ifdef _DEBUG
+        auto const previous = get_allocation_hooks();
+        XLANG_ASSERT((previous.allocate == hooks.allocate && previous.deallocate == hooks.deallocate) || impl::g_pool_live_count == 0);
+#endif
+        impl::g_allocate_hook.store(hooks.allocate, std::memory_order_relaxed);
+        impl::g_deallocate_hook.store(hooks.deallocate, std::memory_order_relaxed);
+    }
+}
@@ -198,6 +198,270 @@ namespace xlang
         size_type m_size{ 0 };
     };
 
+    // Frees memory that came from xlang_mem_alloc. It doesn't destroy the elements.
+    struct mem_deleter
+    {
+        void operator()(void* pointer) const noexcept
+        {
+            xlang_mem_free(pointer);
+        }
+    };
+}
+
+namespace xlang::impl
+{
+    // Passed to mem_allocator::construct for an element that already lives in an adopted buffer. If the
+    // vector was given that buffer the element is left in place, otherwise it is moved from there.
+    template <typename T>
+    struct adopted_element
+    {
+        T* source;
+    };
+
+    // Yields an adopted_element for each element of an adopted buffer, so that a vector constructed from
+    // a range of them takes over the elements.
+    template <typename T>
+    struct adopted_element_iterator
+    {
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = adopted_element<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = adopted_element<T> const*;
+        using reference = adopted_element<T>;
+
+        adopted_element<T> operator*() const noexcept
+        {
+            return { m_current };
+        }
+
+        adopted_element<T> operator[](difference_type const offset) const noexcept
+        {
+            return { m_current + offset };
+        }
+
+        adopted_element_iterator& operator++() noexcept
+        {
+            ++m_current;
+            return *this;
+        }
+
+        adopted_element_iterator operator++(int) noexcept
+        {
+            return { m_current++ };
+        }
+
+        adopted_element_iterator& operator--() noexcept
+        {
+            --m_current;
+            return *this;
+        }
+
+        adopted_element_iterator operator--(int) noexcept
+        {
+            return { m_current-- };
+        }
+
+        adopted_element_iterator& operator+=(difference_type const offset) noexcept
+        {
+            m_current += offset;
+            return *this;
+        }
+
+        adopted_element_iterator& operator-=(difference_type const offset) noexcept
+        {
+            m_current -= offset;
+            return *this;
+        }
+
+        friend adopted_element_iterator operator+(adopted_element_iterator const& left, difference_type const offset) noexcept
+        {
+            return { left.m_current + offset };
+        }
+
+        friend adopted_element_iterator operator+(difference_type const offset, adopted_element_iterator const& right) noexcept
+        {
+            return { right.m_current + offset };
+        }
+
+        friend adopted_element_iterator operator-(adopted_element_iterator const& left, difference_type const offset) noexcept
+        {
+            return { left.m_current - offset };
+        }
+
+        friend difference_type operator-(adopted_element_iterator const& left, adopted_element_iterator const& right) noexcept
+        {
+            return left.m_current - right.m_current;
+        }
+
+        friend bool operator==(adopted_element_iterator const& left, adopted_element_iterator const& right) noexcept
+        {
+            return left.m_current == right.m_current;
+        }
+
+        friend bool operator!=(adopted_element_iterator const& left, adopted_element_iterator const& right) noexcept
+        {
+            return left.m_current != right.m_current;
+        }
+
+        friend bool operator<(adopted_element_iterator const& left, adopted_element_iterator const& right) noexcept
+        {
+            return left.m_current < right.m_current;
+        }
+
+        friend bool operator>(adopted_element_iterator const& left, adopted_element_iterator const& right) noexcept
+        {
+            return left.m_current > right.m_current;
+        }
+
+        friend bool operator<=(adopted_element_iterator const& left, adopted_element_iterator const& right) noexcept
+        {
+            return left.m_current <= right.m_current;
+        }
+
+        friend bool operator>=(adopted_element_iterator const& left, adopted_element_iterator const& right) noexcept
+        {
+            return left.m_current >= right.m_current;
+        }
+
+        T* m_current;
+    };
+
+    // Selects the mem_allocator constructor whose allocator neither destroys nor frees anything, which
+    // lets a vector's buffer and elements outlive the vector.
+    struct release_buffer_t
+    {
+    };
+}
+
+namespace xlang
+{
+    // Allocates from the same heap as the ABI's arrays, so that a std::vector using it can hand its
+    // buffer to a com_array, and take one from a com_array, without copying the elements.
+    template <typename T>
+    struct mem_allocator
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "xlang_mem_alloc does not support over-aligned types.");
+        static_assert(!std::is_same_v<T, bool>, "std::vector<bool> packs its elements into bits, so its buffer can't be shared with com_array<bool>.");
+
+        using value_type = T;
+        using is_always_equal = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+
+        mem_allocator() noexcept = default;
+
+        // The buffer is returned by the first allocation if that is for exactly count elements. Otherwise
+        // it is dropped and the elements are moved from it as they are constructed.
+        mem_allocator(T* adopted, size_t const count) noexcept :
+            m_adopted(adopted),
+            m_adopted_count(count)
+        {
+        }
+
+        explicit mem_allocator(impl::release_buffer_t) noexcept :
+            m_release(true)
+        {
+        }
+
+        template <typename U>
+        mem_allocator(mem_allocator<U> const&) noexcept
+        {
+        }
+
+        T* allocate(size_t const count)
+        {
+            if (auto adopted = std::exchange(m_adopted, nullptr); adopted && count == m_adopted_count)
+            {
+                return adopted;
+            }
+
+            if (count > (std::numeric_limits<size_t>::max)() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+
+            auto result = static_cast<T*>(xlang_mem_alloc(count * sizeof(T)));
+
+            if (result == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            return result;
+        }
+
+        void deallocate(T* pointer, size_t) noexcept
+        {
+            if (!m_release)
+            {
+                xlang_mem_free(pointer);
+            }
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* pointer, Args&&... args)
+        {
+            ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        void construct(U* pointer, impl::adopted_element<U> const element)
+        {
+            if (pointer != element.source)
+            {
+                ::new (static_cast<void*>(pointer)) U(std::move(*element.source));
+            }
+        }
+
+        template <typename U>
+        void destroy(U* pointer) noexcept
+        {
+            if (!m_release)
+            {
+                pointer->~U();
+            }
+        }
+
+        mem_allocator select_on_container_copy_construction() const noexcept
+        {
+            return {};
+        }
+
+        // Any two allocators free each other's memory, but one that still holds an adopted buffer
+        // can't stand in for one that doesn't.
+        template <typename U>
+        bool operator==(mem_allocator<U> const& other) const noexcept
+        {
+            return static_cast<void const*>(m_adopted) == static_cast<void const*>(other.m_adopted);
+        }
+
+        template <typename U>
+        bool operator!=(mem_allocator<U> const& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        template <typename U>
+        friend struct mem_allocator;
+
+        T* m_adopted{};
+        size_t m_adopted_count{};
+        bool m_release{};
+    };
+}
+
+namespace xlang::impl
+{
+    template <typename Allocator>
+    inline constexpr bool is_mem_allocator_v = false;
+
+    template <typename T>
+    inline constexpr bool is_mem_allocator_v<mem_allocator<T>> = true;
+}
+
+namespace xlang
+{
     template <typename T>
     struct com_array : array_view<T>
     {
@@ -242,6 +506,47 @@ namespace xlang
             com_array(value.begin(), value.end())
         {}
 
+        // Takes over the vector's buffer when it comes from mem_allocator. Otherwise the elements are
+        // moved into a new buffer, as the ABI frees arrays with xlang_mem_free.
+        template <typename Allocator>
+        explicit com_array(std::vector<value_type, Allocator>&& value)
+        {
+            if constexpr (impl::is_mem_allocator_v<Allocator>)
+            {
+                XLANG_ASSERT(value.size() <= (std::numeric_limits<size_type>::max)());
+
+                // The buffer moves to a vector whose allocator neither destroys nor frees, so the buffer
+                // and its elements become this array's when that vector goes away. The allocators
+                // compare equal, so the move takes the buffer rather than moving each element.
+                std::vector<value_type, Allocator> owner(std::move(value), Allocator(impl::release_buffer_t{}));
+                this->m_data = owner.data();
+                this->m_size = static_cast<size_type>(owner.size());
+            }
+            else
+            {
+                alloc(static_cast<size_type>(value.size()));
+                std::uninitialized_move(value.begin(), value.end(), this->begin());
+            }
+        }
+
+        // Takes over the buffer when it comes from xlang_mem_alloc, with its first count elements
+        // constructed. Otherwise they are moved into a new buffer and the original is released.
+        template <typename Deleter>
+        com_array(std::unique_ptr<value_type[], Deleter>&& value, size_type const count)
+        {
+            if constexpr (std::is_same_v<Deleter, mem_deleter>)
+            {
+                this->m_data = value.release();
+                this->m_size = this->m_data ? count : 0;
+            }
+            else
+            {
+                alloc(count);
+                std::uninitialized_move(value.get(), value.get() + count, this->begin());
+                value.reset();
+            }
+        }
+
         template <size_type N>
         explicit com_array(std::array<value_type, N> const& value) :
             com_array(value.begin(), value.end())
@@ -376,6 +681,48 @@ namespace xlang
     {
         return detach_abi(object);
     }
+
+    // Moves the array's buffer and elements into a vector without copying them.
+    template <typename T>
+    std::vector<T, mem_allocator<T>> adopt_vector(com_array<T>&& value)
+    {
+        T* const data = value.data();
+        uint32_t const size = value.size();
+        detach_abi(value);
+
+        if (size == 0)
+        {
+            xlang_mem_free(data);
+            return {};
+        }
+
+        // The vector should allocate exactly size elements, receiving the array's buffer, and construct
+        // each from an adopted_element, which leaves the existing element in place. A standard library
+        // that allocates differently gets a new buffer instead, and the elements are moved into it.
+        auto release = [&]
+        {
+            std::destroy_n(data, size);
+            xlang_mem_free(data);
+        };
+
+        try
+        {
+            std::vector<T, mem_allocator<T>> result(impl::adopted_element_iterator<T>{ data }, impl::adopted_element_iterator<T>{ data + size }, mem_allocator<T>(data, size));
+
+            if (result.data() != data)
+            {
+                release();
+            }
+
+            return result;
+        }
+        catch (...)
+        {
+            // Only moving the elements to a new buffer can fail, so the array's buffer is still ours.
+            release();
+            throw;
+        }
+    }
 }
 
 namespace xlang::impl
@@ -87,11 +87,232 @@ namespace xlang::impl
         return fast_iterator<T>(collection, collection.Size());
     }
 
+    // Reads a vector or vector view a block at a time through GetMany, which costs one ABI call per
+    // block rather than one GetAt call per element. The end is fixed when the range is created, as
+    // with fast_iterator. If the collection shrinks, the elements that GetMany no longer returns are
+    // read with GetAt so that iteration fails the same way it would with fast_iterator. Changes made
+    // to elements in a block that has already been read are not observed.
+    template <typename T>
+    struct bulk_vector_range
+    {
+        using value_type = std::decay_t<decltype(std::declval<T const&>().GetAt(0))>;
+
+        struct iterator
+        {
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename bulk_vector_range::value_type;
+            using difference_type = ptrdiff_t;
+            using pointer = value_type*;
+            using reference = value_type&;
+
+            iterator(bulk_vector_range* range, uint32_t const index) noexcept :
+                m_range(range),
+                m_index(index)
+            {
+            }
+
+            iterator& operator++() noexcept
+            {
+                ++m_index;
+                return *this;
+            }
+
+            value_type operator*() const
+            {
+                return m_range->get(m_index);
+            }
+
+            bool operator==(iterator const& other) const noexcept
+            {
+                XLANG_ASSERT(m_range == other.m_range);
+                return m_index == other.m_index;
+            }
+
+            bool operator!=(iterator const& other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+        private:
+
+            bulk_vector_range* m_range;
+            uint32_t m_index;
+        };
+
+        bulk_vector_range(T const& collection, uint32_t const block_size) :
+            m_collection(collection),
+            m_size(collection.Size()),
+            m_items(std::max(block_size, 1u), empty_value<value_type>())
+        {
+        }
+
+        bulk_vector_range(bulk_vector_range const&) = delete;
+        bulk_vector_range& operator=(bulk_vector_range const&) = delete;
+
+        iterator begin() noexcept
+        {
+            return { this, 0 };
+        }
+
+        iterator end() noexcept
+        {
+            return { this, m_size };
+        }
+
+    private:
+
+        value_type get(uint32_t const index)
+        {
+            if (index - m_first >= m_count)
+            {
+                fill(index);
+            }
+
+            if (index - m_first < m_count)
+            {
+                return m_items[index - m_first];
+            }
+
+            return m_collection.GetAt(index);
+        }
+
+        void fill(uint32_t const index)
+        {
+            std::fill_n(m_items.begin(), m_count, empty_value<value_type>());
+            uint32_t const count = std::min(static_cast<uint32_t>(m_items.size()), m_size > index ? m_size - index : 0);
+            m_first = index;
+            m_count = 0;
+            m_count = m_collection.GetMany(index, array_view<value_type>(m_items.data(), m_items.data() + count));
+        }
+
+        // Held by value so that a range over a temporary, such as bulk_range(object.Items()), keeps the
+        // collection alive for the whole loop.
+        T const m_collection;
+        uint32_t const m_size;
+        uint32_t m_first{};
+        uint32_t m_count{};
+        std::vector<value_type> m_items;
+    };
+
+    // Reads an iterable a block at a time through IIterator::GetMany.
+    template <typename T>
+    struct bulk_iterable_range
+    {
+        using iterator_type = decltype(std::declval<T const&>().First());
+        using value_type = std::decay_t<decltype(std::declval<iterator_type const&>().Current())>;
+
+        struct iterator
+        {
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename bulk_iterable_range::value_type;
+            using difference_type = ptrdiff_t;
+            using pointer = value_type*;
+            using reference = value_type&;
+
+            explicit iterator(bulk_iterable_range* range) noexcept :
+                m_range(range)
+            {
+            }
+
+            iterator& operator++()
+            {
+                m_range->next();
+                return *this;
+            }
+
+            value_type operator*() const
+            {
+                return m_range->current();
+            }
+
+            bool operator==(iterator const& other) const noexcept
+            {
+                return done() == other.done();
+            }
+
+            bool operator!=(iterator const& other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+        private:
+
+            bool done() const noexcept
+            {
+                return !m_range || m_range->done();
+            }
+
+            bulk_iterable_range* m_range;
+        };
+
+        bulk_iterable_range(T const& iterable, uint32_t const block_size) :
+            m_iterator(iterable.First()),
+            m_items(std::max(block_size, 1u), empty_value<value_type>())
+        {
+        }
+
+        bulk_iterable_range(bulk_iterable_range const&) = delete;
+        bulk_iterable_range& operator=(bulk_iterable_range const&) = delete;
+
+        iterator begin()
+        {
+            if (!m_started)
+            {
+                m_started = true;
+                fill();
+            }
+
+            return iterator{ this };
+        }
+
+        iterator end() noexcept
+        {
+            return iterator{ nullptr };
+        }
+
+    private:
+
+        bool done() const noexcept
+        {
+            return m_offset == m_count;
+        }
+
+        value_type current() const
+        {
+            XLANG_ASSERT(!done());
+            return m_items[m_offset];
+        }
+
+        void next()
+        {
+            XLANG_ASSERT(!done());
+
+            if (++m_offset == m_count)
+            {
+                fill();
+            }
+        }
+
+        void fill()
+        {
+            std::fill_n(m_items.begin(), m_count, empty_value<value_type>());
+            m_offset = 0;
+            m_count = 0;
+            m_count = m_iterator.GetMany(m_items);
+        }
+
+        iterator_type m_iterator;
+        uint32_t m_offset{};
+        uint32_t m_count{};
+        bool m_started{};
+        std::vector<value_type> m_items;
+    };
+
     template <typename T>
     struct key_value_pair;
 
     template <typename K, typename V>
-    struct key_value_pair<fc::IKeyValuePair<K, V>> : implements<key_value_pair<fc::IKeyValuePair<K, V>>, fc::IKeyValuePair<K, V>>
+    struct key_value_pair<fc::IKeyValuePair<K, V>> : implements<key_value_pair<fc::IKeyValuePair<K, V>>, fc::IKeyValuePair<K, V>, pooled>
     {
         key_value_pair(K key, V value) :
             m_key(std::move(key)),
@@ -209,3 +430,22 @@ namespace xlang::impl
         }
     };
 }
+
+namespace xlang
+{
+    // Iterates over a collection as a range-based for loop would, but reads the elements block_size
+    // at a time with GetMany. Prefer this for large collections implemented in another module, where
+    // each element would otherwise cost a separate call across the ABI.
+    template <typename T>
+    auto bulk_range(T const& collection, uint32_t const block_size = 64)
+    {
+        if constexpr (impl::has_GetAt<T>::value)
+        {
+            return impl::bulk_vector_range<T>(collection, block_size);
+        }
+        else
+        {
+            return impl::bulk_iterable_range<T>(collection, block_size);
+        }
+    }
+}
@@ -18,7 +18,27 @@ namespace xlang
 
         auto First()
         {
-            return make<iterator>(static_cast<D*>(this));
+            // The iterator captures the version and the bounds of the container, so it is built
+            // under the same lock as any other read.
+            return static_cast<D&>(*this).perform_shared([&]
+            {
+                return make<iterator>(static_cast<D*>(this));
+            });
+        }
+
+        // Every read of the container is made through perform_shared and every change through
+        // perform_exclusive. Collections that may be called from several threads at once hide these
+        // with versions that lock the container.
+        template <typename F>
+        auto perform_shared(F&& action) const
+        {
+            return action();
+        }
+
+        template <typename F>
+        auto perform_exclusive(F&& action)
+        {
+            return action();
         }
 
     protected:
@@ -48,12 +68,11 @@ namespace xlang
 
     private:
 
-        struct iterator : Version::iterator_type, implements<iterator, Foundation::Collections::IIterator<T>>
+        struct iterator : Version::iterator_type, implements<iterator, Foundation::Collections::IIterator<T>, pooled>
         {
             void abi_enter()
             {
                 m_owner->abi_enter();
-                this->check_version(*m_owner);
             }
 
             void abi_exit()
@@ -71,42 +90,60 @@ namespace xlang
 
             T Current() const
             {
-                if (m_current == m_end)
+                return m_owner->perform_shared([&]
                 {
-                    throw out_of_bounds_error();
-                }
+                    this->check_version(*m_owner);
 
-                if constexpr (!impl::is_key_value_pair<T>::value)
-                {
-                    return m_owner->unwrap_value(*m_current);
-                }
-                else
-                {
-                    return make<impl::key_value_pair<T>>(m_owner->unwrap_value(m_current->first), m_owner->unwrap_value(m_current->second));
-                }
+                    if (m_current == m_end)
+                    {
+                        throw out_of_bounds_error();
+                    }
+
+                    if constexpr (!impl::is_key_value_pair<T>::value)
+                    {
+                        return m_owner->unwrap_value(*m_current);
+                    }
+                    else
+                    {
+                        return make<impl::key_value_pair<T>>(m_owner->unwrap_value(m_current->first), m_owner->unwrap_value(m_current->second));
+                    }
+                });
             }
 
-            bool HasCurrent() const noexcept
+            bool HasCurrent() const
             {
-                return m_current != m_end;
+                return m_owner->perform_shared([&]
+                {
+                    this->check_version(*m_owner);
+                    return m_current != m_end;
+                });
             }
 
-            bool MoveNext() noexcept
+            bool MoveNext()
             {
-                if (m_current != m_end)
+                return m_owner->perform_shared([&]
                 {
-                    ++m_current;
-                }
+                    this->check_version(*m_owner);
+
+                    if (m_current != m_end)
+                    {
+                        ++m_current;
+                    }
 
-                return HasCurrent();
+                    return m_current != m_end;
+                });
             }
 
             uint32_t GetMany(array_view<T> values)
             {
-                uint32_t const actual = (std::min)(static_cast<uint32_t>(std::distance(m_current, m_end)), values.size());
-                m_owner->copy_n(m_current, actual, values.begin());
-                std::advance(m_current, actual);
-                return actual;
+                return m_owner->perform_shared([&]
+                {
+                    this->check_version(*m_owner);
+                    uint32_t const actual = (std::min)(static_cast<uint32_t>(std::distance(m_current, m_end)), values.size());
+                    m_owner->copy_n(m_current, actual, values.begin());
+                    std::advance(m_current, actual);
+                    return actual;
+                });
             }
 
         private:
@@ -122,40 +159,61 @@ namespace xlang
     {
         T GetAt(uint32_t const index) const
         {
-            if (index >= Size())
+            return static_cast<D const&>(*this).perform_shared([&]
             {
-                throw out_of_bounds_error();
-            }
+                if (index >= container_size())
+                {
+                    throw out_of_bounds_error();
+                }
 
-            return static_cast<D const&>(*this).unwrap_value(*std::next(static_cast<D const&>(*this).get_container().begin(), index));
+                return static_cast<D const&>(*this).unwrap_value(*std::next(static_cast<D const&>(*this).get_container().begin(), index));
+            });
         }
 
         uint32_t Size() const noexcept
         {
-            return static_cast<uint32_t>(std::distance(static_cast<D const&>(*this).get_container().begin(), static_cast<D const&>(*this).get_container().end()));
+            return static_cast<D const&>(*this).perform_shared([&]
+            {
+                return container_size();
+            });
         }
 
         bool IndexOf(T const& value, uint32_t& index) const noexcept
         {
-            auto first = std::find_if(static_cast<D const&>(*this).get_container().begin(), static_cast<D const&>(*this).get_container().end(), [&](auto&& match)
+            return static_cast<D const&>(*this).perform_shared([&]
             {
-                return value == static_cast<D const&>(*this).unwrap_value(match);
-            });
+                auto first = std::find_if(static_cast<D const&>(*this).get_container().begin(), static_cast<D const&>(*this).get_container().end(), [&](auto&& match)
+                {
+                    return value == static_cast<D const&>(*this).unwrap_value(match);
+                });
 
-            index = static_cast<uint32_t>(first - static_cast<D const&>(*this).get_container().begin());
-            return index < Size();
+                index = static_cast<uint32_t>(first - static_cast<D const&>(*this).get_container().begin());
+                return index < container_size();
+            });
         }
 
         uint32_t GetMany(uint32_t const startIndex, array_view<T> values) const
         {
-            if (startIndex >= Size())
+            return static_cast<D const&>(*this).perform_shared([&]
             {
-                return 0;
-            }
+                uint32_t const size = container_size();
+
+                if (startIndex >= size)
+                {
+                    return 0u;
+                }
 
-            uint32_t const actual = (std::min)(Size() - startIndex, values.size());
-            this->copy_n(static_cast<D const&>(*this).get_container().begin() + startIndex, actual, values.begin());
-            return actual;
+                uint32_t const actual = (std::min)(size - startIndex, values.size());
+                this->copy_n(static_cast<D const&>(*this).get_container().begin() + startIndex, actual, values.begin());
+                return actual;
+            });
+        }
+
+    private:
+
+        uint32_t container_size() const noexcept
+        {
+            return static_cast<uint32_t>(std::distance(static_cast<D const&>(*this).get_container().begin(), static_cast<D const&>(*this).get_container().end()));
         }
     };
 
@@ -169,64 +227,85 @@ namespace xlang
 
         void SetAt(uint32_t const index, T const& value)
         {
-            if (index >= static_cast<D const&>(*this).get_container().size())
+            static_cast<D&>(*this).perform_exclusive([&]
             {
-                throw out_of_bounds_error();
-            }
+                if (index >= static_cast<D const&>(*this).get_container().size())
+                {
+                    throw out_of_bounds_error();
+                }
 
-            this->increment_version();
-            static_cast<D&>(*this).get_container()[index] = static_cast<D const&>(*this).wrap_value(value);
+                this->increment_version();
+                static_cast<D&>(*this).get_container()[index] = static_cast<D const&>(*this).wrap_value(value);
+            });
         }
 
         void InsertAt(uint32_t const index, T const& value)
         {
-            if (index > static_cast<D const&>(*this).get_container().size())
+            static_cast<D&>(*this).perform_exclusive([&]
             {
-                throw out_of_bounds_error();
-            }
+                if (index > static_cast<D const&>(*this).get_container().size())
+                {
+                    throw out_of_bounds_error();
+                }
 
-            this->increment_version();
-            static_cast<D&>(*this).get_container().insert(static_cast<D const&>(*this).get_container().begin() + index, static_cast<D const&>(*this).wrap_value(value));
+                this->increment_version();
+                static_cast<D&>(*this).get_container().insert(static_cast<D const&>(*this).get_container().begin() + index, static_cast<D const&>(*this).wrap_value(value));
+            });
         }
 
         void RemoveAt(uint32_t const index)
         {
-            if (index >= static_cast<D const&>(*this).get_container().size())
+            static_cast<D&>(*this).perform_exclusive([&]
             {
-                throw out_of_bounds_error();
-            }
+                if (index >= static_cast<D const&>(*this).get_container().size())
+                {
+                    throw out_of_bounds_error();
+                }
 
-            this->increment_version();
-            static_cast<D&>(*this).get_container().erase(static_cast<D const&>(*this).get_container().begin() + index);
+                this->increment_version();
+                static_cast<D&>(*this).get_container().erase(static_cast<D const&>(*this).get_container().begin() + index);
+            });
         }
 
         void Append(T const& value)
         {
-            this->increment_version();
-            static_cast<D&>(*this).get_container().push_back(static_cast<D const&>(*this).wrap_value(value));
+            static_cast<D&>(*this).perform_exclusive([&]
+            {
+                this->increment_version();
+                static_cast<D&>(*this).get_container().push_back(static_cast<D const&>(*this).wrap_value(value));
+            });
         }
 
         void RemoveAtEnd()
         {
-            if (static_cast<D const&>(*this).get_container().empty())
+            static_cast<D&>(*this).perform_exclusive([&]
             {
-                throw out_of_bounds_error();
-            }
+                if (static_cast<D const&>(*this).get_container().empty())
+                {
+                    throw out_of_bounds_error();
+                }
 
-            this->increment_version();
-            static_cast<D&>(*this).get_container().pop_back();
+                this->increment_version();
+                static_cast<D&>(*this).get_container().pop_back();
+            });
         }
 
         void Clear() noexcept
         {
-            this->increment_version();
-            static_cast<D&>(*this).get_container().clear();
+            static_cast<D&>(*this).perform_exclusive([&]
+            {
+                this->increment_version();
+                static_cast<D&>(*this).get_container().clear();
+            });
         }
 
         void ReplaceAll(array_view<T const> value)
         {
-            this->increment_version();
-            assign(value.begin(), value.end());
+            static_cast<D&>(*this).perform_exclusive([&]
+            {
+                this->increment_version();
+                assign(value.begin(), value.end());
+            });
         }
 
     private:
@@ -259,24 +338,33 @@ namespace xlang
     {
         V Lookup(K const& key) const
         {
-            auto pair = static_cast<D const&>(*this).get_container().find(static_cast<D const&>(*this).wrap_value(key));
-
-            if (pair == static_cast<D const&>(*this).get_container().end())
+            return static_cast<D const&>(*this).perform_shared([&]
             {
-                throw out_of_bounds_error();
-            }
+                auto pair = static_cast<D const&>(*this).get_container().find(static_cast<D const&>(*this).wrap_value(key));
 
-            return static_cast<D const&>(*this).unwrap_value(pair->second);
+                if (pair == static_cast<D const&>(*this).get_container().end())
+                {
+                    throw out_of_bounds_error();
+                }
+
+                return static_cast<D const&>(*this).unwrap_value(pair->second);
+            });
         }
 
         uint32_t Size() const noexcept
         {
-            return static_cast<uint32_t>(static_cast<D const&>(*this).get_container().size());
+            return static_cast<D const&>(*this).perform_shared([&]
+            {
+                return static_cast<uint32_t>(static_cast<D const&>(*this).get_container().size());
+            });
         }
 
         bool HasKey(K const& key) const noexcept
         {
-            return static_cast<D const&>(*this).get_container().find(static_cast<D const&>(*this).wrap_value(key)) != static_cast<D const&>(*this).get_container().end();
+            return static_cast<D const&>(*this).perform_shared([&]
+            {
+                return static_cast<D const&>(*this).get_container().find(static_cast<D const&>(*this).wrap_value(key)) != static_cast<D const&>(*this).get_container().end();
+            });
         }
     };
 
@@ -290,21 +378,30 @@ namespace xlang
 
         bool Insert(K const& key, V const& value)
         {
-            this->increment_version();
-            auto pair = static_cast<D&>(*this).get_container().insert_or_assign(static_cast<D const&>(*this).wrap_value(key), static_cast<D const&>(*this).wrap_value(value));
-            return !pair.second;
+            return static_cast<D&>(*this).perform_exclusive([&]
+            {
+                this->increment_version();
+                auto pair = static_cast<D&>(*this).get_container().insert_or_assign(static_cast<D const&>(*this).wrap_value(key), static_cast<D const&>(*this).wrap_value(value));
+                return !pair.second;
+            });
         }
 
         void Remove(K const& key)
         {
-            this->increment_version();
-            static_cast<D&>(*this).get_container().erase(static_cast<D const&>(*this).wrap_value(key));
+            static_cast<D&>(*this).perform_exclusive([&]
+            {
+                this->increment_version();
+                static_cast<D&>(*this).get_container().erase(static_cast<D const&>(*this).wrap_value(key));
+            });
         }
 
         void Clear() noexcept
         {
-            this->increment_version();
-            static_cast<D&>(*this).get_container().clear();
+            static_cast<D&>(*this).perform_exclusive([&]
+            {
+                this->increment_version();
+                static_cast<D&>(*this).get_container().clear();
+            });
         }
     };
 }
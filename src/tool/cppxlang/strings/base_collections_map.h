@@ -1,4 +1,251 @@
 
+namespace xlang::impl
+{
+    // An open-addressing hash table that backs the hash-based maps. Entries are stored densely in
+    // insertion order and located through a power-of-two table of slots that is probed linearly. Each
+    // slot caches the full hash of its key, so a probe only compares keys whose hashes match and growing
+    // the table never hashes a key again. Removing an entry moves the last entry into its place.
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    struct hash_map
+    {
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K, V>;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        hash_map() = default;
+
+        template <typename InputIt>
+        hash_map(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                insert_or_assign(first->first, first->second);
+            }
+        }
+
+        iterator begin() noexcept
+        {
+            return m_entries.begin();
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_entries.begin();
+        }
+
+        iterator end() noexcept
+        {
+            return m_entries.end();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_entries.end();
+        }
+
+        size_t size() const noexcept
+        {
+            return m_entries.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_entries.empty();
+        }
+
+        iterator find(K const& key)
+        {
+            size_t const slot = find_slot(key, m_hash(key));
+            return slot == npos ? end() : begin() + m_slots[slot].index;
+        }
+
+        const_iterator find(K const& key) const
+        {
+            size_t const slot = find_slot(key, m_hash(key));
+            return slot == npos ? end() : begin() + m_slots[slot].index;
+        }
+
+        template <typename M>
+        std::pair<iterator, bool> insert_or_assign(K const& key, M&& value)
+        {
+            size_t const hash = m_hash(key);
+            size_t const slot = find_slot(key, hash);
+
+            if (slot != npos)
+            {
+                auto entry = begin() + m_slots[slot].index;
+                entry->second = std::forward<M>(value);
+                return { entry, false };
+            }
+
+            if ((m_entries.size() + 1) * 4 > m_slots.size() * 3)
+            {
+                rehash((std::max)(m_slots.size() * 2, size_t{ 8 }));
+            }
+
+            m_entries.emplace_back(key, std::forward<M>(value));
+            m_slots[free_slot(hash)] = { hash, static_cast<uint32_t>(m_entries.size() - 1) };
+            return { end() - 1, true };
+        }
+
+        size_t erase(K const& key)
+        {
+            size_t slot = find_slot(key, m_hash(key));
+
+            if (slot == npos)
+            {
+                return 0;
+            }
+
+            uint32_t const index = m_slots[slot].index;
+            uint32_t const last = static_cast<uint32_t>(m_entries.size() - 1);
+
+            if (index != last)
+            {
+                m_slots[slot_of(last)].index = index;
+                m_entries[index] = std::move(m_entries[last]);
+            }
+
+            m_entries.pop_back();
+            remove_slot(slot);
+            return 1;
+        }
+
+        void clear() noexcept
+        {
+            m_entries.clear();
+            std::fill(m_slots.begin(), m_slots.end(), slot_type{});
+        }
+
+        void reserve(size_t const count)
+        {
+            size_t capacity = 8;
+
+            while (count * 4 > capacity * 3)
+            {
+                capacity *= 2;
+            }
+
+            if (capacity > m_slots.size())
+            {
+                rehash(capacity);
+            }
+
+            m_entries.reserve(count);
+        }
+
+    private:
+
+        static constexpr size_t npos = ~size_t{};
+        static constexpr uint32_t empty_index = ~uint32_t{};
+
+        struct slot_type
+        {
+            size_t hash{};
+            uint32_t index{ empty_index };
+        };
+
+        // Fibonacci hashing spreads keys whose hashes differ only in their upper bits.
+        size_t home(size_t const hash) const noexcept
+        {
+            return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15) >> m_shift);
+        }
+
+        size_t next(size_t const slot) const noexcept
+        {
+            return (slot + 1) & (m_slots.size() - 1);
+        }
+
+        size_t find_slot(K const& key, size_t const hash) const
+        {
+            if (m_slots.empty())
+            {
+                return npos;
+            }
+
+            for (size_t slot = home(hash); m_slots[slot].index != empty_index; slot = next(slot))
+            {
+                if (m_slots[slot].hash == hash && m_equal(m_entries[m_slots[slot].index].first, key))
+                {
+                    return slot;
+                }
+            }
+
+            return npos;
+        }
+
+        size_t free_slot(size_t const hash) const noexcept
+        {
+            size_t slot = home(hash);
+
+            while (m_slots[slot].index != empty_index)
+            {
+                slot = next(slot);
+            }
+
+            return slot;
+        }
+
+        size_t slot_of(uint32_t const index) const
+        {
+            size_t slot = home(m_hash(m_entries[index].first));
+
+            while (m_slots[slot].index != index)
+            {
+                slot = next(slot);
+            }
+
+            return slot;
+        }
+
+        // Shifts later entries of the probe sequence back so that lookups never need tombstones.
+        void remove_slot(size_t slot) noexcept
+        {
+            for (size_t candidate = next(slot); m_slots[candidate].index != empty_index; candidate = next(candidate))
+            {
+                size_t const ideal = home(m_slots[candidate].hash);
+
+                if (((candidate - ideal) & (m_slots.size() - 1)) >= ((candidate - slot) & (m_slots.size() - 1)))
+                {
+                    m_slots[slot] = m_slots[candidate];
+                    slot = candidate;
+                }
+            }
+
+            m_slots[slot] = {};
+        }
+
+        void rehash(size_t const capacity)
+        {
+            std::vector<slot_type> previous(capacity);
+            std::swap(previous, m_slots);
+
+            m_shift = 64;
+
+            for (size_t remaining = capacity; remaining > 1; remaining /= 2)
+            {
+                --m_shift;
+            }
+
+            for (auto&& slot : previous)
+            {
+                if (slot.index != empty_index)
+                {
+                    m_slots[free_slot(slot.hash)] = slot;
+                }
+            }
+        }
+
+        std::vector<value_type> m_entries;
+        std::vector<slot_type> m_slots;
+        uint32_t m_shift{ 64 };
+        Hash m_hash;
+        KeyEqual m_equal;
+    };
+}
+
 namespace xlang
 {
     template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
@@ -18,4 +265,85 @@ namespace xlang
     {
         return make<impl::input_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
     }
+
+    // A map backed by an open-addressing hash table. Lookups cost one hash and, usually, one key
+    // comparison. Iteration follows insertion order until an element is removed.
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    Foundation::Collections::IMap<K, V> single_threaded_hash_map()
+    {
+        return make<impl::input_map<K, V, impl::hash_map<K, V, Hash, KeyEqual>>>(impl::hash_map<K, V, Hash, KeyEqual>{});
+    }
+
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Foundation::Collections::IMap<K, V> single_threaded_hash_map(std::unordered_map<K, V, Hash, KeyEqual, Allocator> const& values)
+    {
+        return make<impl::input_map<K, V, impl::hash_map<K, V, Hash, KeyEqual>>>(impl::hash_map<K, V, Hash, KeyEqual>(values.begin(), values.end()));
+    }
+}
+
+namespace xlang::impl
+{
+    template <typename K, typename V, typename Container>
+    struct multi_threaded_map :
+        implements<multi_threaded_map<K, V, Container>, fc::IMap<K, V>, fc::IMapView<K, V>, fc::IIterable<fc::IKeyValuePair<K, V>>>,
+        map_base<multi_threaded_map<K, V, Container>, K, V>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+
+        explicit multi_threaded_map(Container&& values) : m_values(std::forward<Container>(values))
+        {
+        }
+
+        auto& get_container() noexcept
+        {
+            return m_values;
+        }
+
+        auto& get_container() const noexcept
+        {
+            return m_values;
+        }
+
+        template <typename F>
+        auto perform_shared(F&& action) const
+        {
+            std::shared_lock const guard(m_lock);
+            return action();
+        }
+
+        template <typename F>
+        auto perform_exclusive(F&& action)
+        {
+            std::unique_lock const guard(m_lock);
+            return action();
+        }
+
+    private:
+
+        Container m_values;
+        mutable std::shared_mutex m_lock;
+    };
+}
+
+namespace xlang
+{
+    // A map that may be shared between threads. Reads take a shared lock and changes take an exclusive
+    // lock. As with single_threaded_map, iterators fail once the map has changed.
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    Foundation::Collections::IMap<K, V> multi_threaded_map()
+    {
+        return make<impl::multi_threaded_map<K, V, impl::hash_map<K, V, Hash, KeyEqual>>>(impl::hash_map<K, V, Hash, KeyEqual>{});
+    }
+
+    template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Foundation::Collections::IMap<K, V> multi_threaded_map(std::map<K, V, Compare, Allocator>&& values)
+    {
+        return make<impl::multi_threaded_map<K, V, std::map<K, V, Compare, Allocator>>>(std::move(values));
+    }
+
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Foundation::Collections::IMap<K, V> multi_threaded_map(std::unordered_map<K, V, Hash, KeyEqual, Allocator>&& values)
+    {
+        return make<impl::multi_threaded_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
+    }
 }
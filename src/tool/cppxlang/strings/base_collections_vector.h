@@ -7,3 +7,58 @@ namespace xlang
         return make<impl::input_vector<T, std::vector<T, Allocator>>>(std::move(values));
     }
 }
+
+namespace xlang::impl
+{
+    template <typename T, typename Container>
+    struct multi_threaded_vector :
+        implements<multi_threaded_vector<T, Container>, fc::IVector<T>, fc::IVectorView<T>, fc::IIterable<T>>,
+        vector_base<multi_threaded_vector<T, Container>, T>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+
+        explicit multi_threaded_vector(Container&& values) : m_values(std::forward<Container>(values))
+        {
+        }
+
+        auto& get_container() noexcept
+        {
+            return m_values;
+        }
+
+        auto& get_container() const noexcept
+        {
+            return m_values;
+        }
+
+        template <typename F>
+        auto perform_shared(F&& action) const
+        {
+            std::shared_lock const guard(m_lock);
+            return action();
+        }
+
+        template <typename F>
+        auto perform_exclusive(F&& action)
+        {
+            std::unique_lock const guard(m_lock);
+            return action();
+        }
+
+    private:
+
+        Container m_values;
+        mutable std::shared_mutex m_lock;
+    };
+}
+
+namespace xlang
+{
+    // A vector that may be shared between threads. Reads take a shared lock and changes take an exclusive
+    // lock. As with single_threaded_vector, iterators fail once the vector has changed.
+    template <typename T, typename Allocator = std::allocator<T>>
+    Foundation::Collections::IVector<T> multi_threaded_vector(std::vector<T, Allocator>&& values = {})
+    {
+        return make<impl::multi_threaded_vector<T, std::vector<T, Allocator>>>(std::move(values));
+    }
+}
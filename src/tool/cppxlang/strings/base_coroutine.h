@@ -1,5 +1,4 @@
 
-#ifdef _WIN32
 namespace xlang::impl
 {
     template <typename Async>
@@ -14,6 +13,7 @@ namespace xlang::impl
 
         void await_suspend(std::experimental::coroutine_handle<> handle) const
         {
+#ifdef _WIN32
             auto context = capture<IContextCallback>(XLANG_CoGetObjectContext);
 
             async.Completed([handle, context = std::move(context)](auto const&, Foundation::AsyncStatus)
@@ -29,6 +29,9 @@ namespace xlang::impl
 
                 check_xlang_error(context->ContextCallback(callback, &args, guid_of<impl::ICallbackWithNoReentrancyToApplicationSTA>(), 5, nullptr));
             });
+#else
+            resume_on_completed(async, handle);
+#endif
         }
 
         auto await_resume() const
@@ -38,7 +41,7 @@ namespace xlang::impl
     };
 }
 
-#ifdef _RESUMABLE_FUNCTIONS_SUPPORTED
+#if defined(_RESUMABLE_FUNCTIONS_SUPPORTED) || defined(__cpp_coroutines)
 namespace xlang::Foundation
 {
     inline impl::await_adapter<IAsyncAction> operator co_await(IAsyncAction const& async)
@@ -414,5 +417,3 @@ namespace xlang::impl
         bool m_completed_assigned{ false };
     };
 }
-
-#endif
\ No newline at end of file
@@ -2,7 +2,7 @@
 namespace xlang::impl
 {
     template <typename T, typename H>
-    struct implements_delegate : abi_t<T>, H
+    struct implements_delegate : abi_t<T>, H, pooled_allocation
     {
         implements_delegate(H&& handler) : H(std::forward<H>(handler)) {}
 
@@ -55,7 +55,7 @@ namespace xlang::impl
     };
 
     template <typename H, typename... T>
-    struct variadic_delegate final : variadic_delegate_abi<T...>, H
+    struct variadic_delegate final : variadic_delegate_abi<T...>, H, pooled_allocation
     {
         variadic_delegate(H&& handler) : H(std::forward<H>(handler)) {}
 
@@ -284,8 +284,9 @@ namespace xlang::impl
             if (remaining == 0)
             {
                 std::atomic_thread_fence(std::memory_order_acquire);
+                size_t const size = sizeof(event_array) + sizeof(value_type) * m_size;
                 this->~event_array();
-                ::operator delete(static_cast<void*>(this));
+                pool_deallocate(static_cast<void*>(this), size);
             }
 
             return remaining;
@@ -331,7 +332,7 @@ namespace xlang::impl
     template <typename T>
     com_ptr<event_array<T>> make_event_array(uint32_t const capacity)
     {
-        void* raw = ::operator new(sizeof(event_array<T>) + (sizeof(T)* capacity));
+        void* raw = pool_allocate(sizeof(event_array<T>) + (sizeof(T)* capacity));
 #pragma warning(suppress: 6386)
         return { new(raw) event_array<T>(capacity), take_ownership_from_abi };
     }
@@ -339,6 +340,10 @@ namespace xlang::impl
 
 namespace xlang
 {
+    // Raising an event never blocks. A raise registers with one of two reader counts just long enough
+    // to take a reference on the current targets array, then invokes the delegates outside of that
+    // window. Adding or removing a delegate swaps in a new array, flips the active reader count, and
+    // waits for raises that may still be taking a reference on the old array before releasing it.
     template <typename Delegate>
     struct event
     {
@@ -348,9 +353,15 @@ namespace xlang
         event(event<Delegate> const&) = delete;
         event<Delegate>& operator =(event<Delegate> const&) = delete;
 
+        ~event() noexcept
+        {
+            delegate_array targets;
+            targets.attach(m_targets.load(std::memory_order_relaxed));
+        }
+
         explicit operator bool() const noexcept
         {
-            return m_targets != nullptr;
+            return m_targets.load(std::memory_order_relaxed) != nullptr;
         }
 
         event_token add(delegate_type const& delegate)
@@ -362,18 +373,18 @@ namespace xlang
 
             {
                 std::lock_guard const change_guard(m_change);
-                delegate_array new_targets = impl::make_event_array<delegate_type>((!m_targets) ? 1 : m_targets->size() + 1);
+                auto const targets = m_targets.load(std::memory_order_relaxed);
+                delegate_array new_targets = impl::make_event_array<delegate_type>((!targets) ? 1 : targets->size() + 1);
 
-                if (m_targets)
+                if (targets)
                 {
-                    std::copy_n(m_targets->begin(), m_targets->size(), new_targets->begin());
+                    std::copy_n(targets->begin(), targets->size(), new_targets->begin());
                 }
 
                 new_targets->back() = delegate;
                 token = get_token(new_targets->back());
 
-                std::lock_guard const swap_guard(m_swap);
-                temp_targets = std::exchange(m_targets, std::move(new_targets));
+                temp_targets = exchange_targets(std::move(new_targets));
             }
 
             return token;
@@ -386,19 +397,20 @@ namespace xlang
 
             {
                 std::lock_guard const change_guard(m_change);
+                auto const targets = m_targets.load(std::memory_order_relaxed);
 
-                if (!m_targets)
+                if (!targets)
                 {
                     return;
                 }
 
-                uint32_t available_slots = m_targets->size() - 1;
+                uint32_t available_slots = targets->size() - 1;
                 delegate_array new_targets;
                 bool removed = false;
 
                 if (available_slots == 0)
                 {
-                    if (get_token(*m_targets->begin()) == token)
+                    if (get_token(*targets->begin()) == token)
                     {
                         removed = true;
                     }
@@ -408,7 +420,7 @@ namespace xlang
                     new_targets = impl::make_event_array<delegate_type>(available_slots);
                     auto new_iterator = new_targets->begin();
 
-                    for (delegate_type const& element : *m_targets)
+                    for (delegate_type const& element : *targets)
                     {
                         if (!removed && token == get_token(element))
                         {
@@ -430,8 +442,7 @@ namespace xlang
 
                 if (removed)
                 {
-                    std::lock_guard const swap_guard(m_swap);
-                    temp_targets = std::exchange(m_targets, std::move(new_targets));
+                    temp_targets = exchange_targets(std::move(new_targets));
                 }
             }
         }
@@ -439,12 +450,7 @@ namespace xlang
         template<typename...Arg>
         void operator()(Arg const&... args)
         {
-            delegate_array temp_targets;
-
-            {
-                std::lock_guard const swap_guard(m_swap);
-                temp_targets = m_targets;
-            }
+            delegate_array temp_targets = acquire_targets();
 
             if (temp_targets)
             {
@@ -463,15 +469,48 @@ namespace xlang
 
     private:
 
+        using delegate_array = com_ptr<impl::event_array<delegate_type>>;
+
         event_token get_token(delegate_type const& delegate) const noexcept
         {
             return event_token{ reinterpret_cast<int64_t>(get_abi(delegate)) };
         }
 
-        using delegate_array = com_ptr<impl::event_array<delegate_type>>;
+        delegate_array acquire_targets() noexcept
+        {
+            delegate_array targets;
+            auto& readers = m_readers[m_reader_index.load()];
+            ++readers;
+            targets.copy_from(m_targets.load());
+            --readers;
+            return targets;
+        }
+
+        // Must be called with m_change held. Returns the previous array once no raise can still be
+        // taking a reference on it.
+        delegate_array exchange_targets(delegate_array&& targets) noexcept
+        {
+            delegate_array previous;
+            previous.attach(m_targets.exchange(targets.detach()));
+
+            uint32_t const current = m_reader_index.load();
+            wait_for_readers(m_readers[current ^ 1]);
+            m_reader_index.store(current ^ 1);
+            wait_for_readers(m_readers[current]);
+            return previous;
+        }
+
+        static void wait_for_readers(std::atomic<uint32_t> const& readers) noexcept
+        {
+            while (readers.load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
 
-        delegate_array m_targets;
-        std::mutex m_swap;
+        std::atomic<impl::event_array<delegate_type>*> m_targets{};
+        std::atomic<uint32_t> m_reader_index{};
+        std::atomic<uint32_t> m_readers[2]{};
         std::mutex m_change;
     };
 }
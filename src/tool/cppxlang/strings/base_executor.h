@@ -0,0 +1,583 @@
+
+namespace xlang::impl
+{
+    struct executor_work
+    {
+        void(*callback)(void* context);
+        void* context;
+    };
+
+    // Each worker owns a queue. The owner takes the most recently queued work while idle workers
+    // steal the oldest work from the other end.
+    struct executor_queue
+    {
+        void push(executor_work const& work)
+        {
+            std::lock_guard const guard(m_lock);
+            m_items.push_back(work);
+        }
+
+        bool pop(executor_work& work)
+        {
+            std::lock_guard const guard(m_lock);
+
+            if (m_items.empty())
+            {
+                return false;
+            }
+
+            work = m_items.back();
+            m_items.pop_back();
+            return true;
+        }
+
+        bool steal(executor_work& work)
+        {
+            std::lock_guard const guard(m_lock);
+
+            if (m_items.empty())
+            {
+                return false;
+            }
+
+            work = m_items.front();
+            m_items.pop_front();
+            return true;
+        }
+
+    private:
+
+        std::mutex m_lock;
+        std::deque<executor_work> m_items;
+    };
+
+    // A hashed timer wheel with a fixed tick. Timers land in the slot of their due tick, and timers
+    // further out than one rotation simply stay in their slot until their turn comes around.
+    struct timer_wheel
+    {
+        using clock = std::chrono::steady_clock;
+        using tick = std::chrono::milliseconds;
+        static constexpr size_t slot_count = 256;
+
+        explicit timer_wheel(clock::time_point now) noexcept :
+            m_current(to_tick(now))
+        {
+        }
+
+        void add(clock::time_point due, executor_work const& work)
+        {
+            // Round up so that a timer never fires before it is due.
+            int64_t const due_tick = std::max(std::chrono::ceil<tick>(due.time_since_epoch()).count(), m_current);
+            m_slots[static_cast<size_t>(due_tick) % slot_count].push_back({ due_tick, work });
+            ++m_count;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_count == 0;
+        }
+
+        // Moves the timers that are due by now into ready and returns the time of the next tick
+        // that has a timer in it.
+        std::optional<clock::time_point> advance(clock::time_point now, std::vector<executor_work>& ready)
+        {
+            int64_t const now_tick = to_tick(now);
+
+            // After a long gap, every slot has been passed at least once.
+            int64_t const first = std::max(m_current, now_tick - static_cast<int64_t>(slot_count) + 1);
+
+            for (int64_t current = first; current <= now_tick && m_count != 0; ++current)
+            {
+                auto& slot = m_slots[static_cast<size_t>(current) % slot_count];
+
+                auto const expired = std::partition(slot.begin(), slot.end(), [now_tick](entry const& value)
+                {
+                    return value.due_tick > now_tick;
+                });
+
+                for (auto it = expired; it != slot.end(); ++it)
+                {
+                    ready.push_back(it->work);
+                }
+
+                m_count -= static_cast<size_t>(slot.end() - expired);
+                slot.erase(expired, slot.end());
+            }
+
+            m_current = std::max(m_current, now_tick + 1);
+            return next_due();
+        }
+
+    private:
+
+        struct entry
+        {
+            int64_t due_tick;
+            executor_work work;
+        };
+
+        static int64_t to_tick(clock::time_point value) noexcept
+        {
+            return std::chrono::duration_cast<tick>(value.time_since_epoch()).count();
+        }
+
+        static clock::time_point from_tick(int64_t value) noexcept
+        {
+            return clock::time_point{ std::chrono::duration_cast<clock::duration>(tick{ value }) };
+        }
+
+        std::optional<clock::time_point> next_due() const noexcept
+        {
+            if (m_count == 0)
+            {
+                return {};
+            }
+
+            // Look for a timer within the next rotation first, which is the common case.
+            for (int64_t current = m_current; current != m_current + static_cast<int64_t>(slot_count); ++current)
+            {
+                for (auto&& value : m_slots[static_cast<size_t>(current) % slot_count])
+                {
+                    if (value.due_tick == current)
+                    {
+                        return from_tick(current);
+                    }
+                }
+            }
+
+            int64_t earliest = std::numeric_limits<int64_t>::max();
+
+            for (auto&& slot : m_slots)
+            {
+                for (auto&& value : slot)
+                {
+                    earliest = std::min(earliest, value.due_tick);
+                }
+            }
+
+            return from_tick(earliest);
+        }
+
+        std::array<std::vector<entry>, slot_count> m_slots;
+        int64_t m_current;
+        size_t m_count{};
+    };
+
+    template <typename F>
+    void invoke_executor_function(void* context)
+    {
+        std::unique_ptr<F> function{ static_cast<F*>(context) };
+        (*function)();
+    }
+
+#ifdef __linux__
+    struct executor_reactor
+    {
+        struct registration
+        {
+            void(*callback)(void* context, uint32_t events);
+            void* context;
+            uint32_t events;
+        };
+
+        executor_reactor()
+        {
+            m_epoll = epoll_create1(EPOLL_CLOEXEC);
+
+            if (m_epoll == -1)
+            {
+                throw std::system_error(errno, std::system_category());
+            }
+
+            m_wake = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+            if (m_wake == -1)
+            {
+                int const error = errno;
+                ::close(m_epoll);
+                throw std::system_error(error, std::system_category());
+            }
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = nullptr;
+
+            if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &event) == -1)
+            {
+                int const error = errno;
+                ::close(m_wake);
+                ::close(m_epoll);
+                throw std::system_error(error, std::system_category());
+            }
+        }
+
+        ~executor_reactor() noexcept
+        {
+            ::close(m_wake);
+            ::close(m_epoll);
+        }
+
+        // Registers a single wait on the file descriptor. A file descriptor may only have one
+        // outstanding wait at a time.
+        void add(int fd, uint32_t events, registration* value)
+        {
+            epoll_event event{};
+            event.events = events | EPOLLONESHOT;
+            event.data.ptr = value;
+
+            if (epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &event) == -1)
+            {
+                if (errno != ENOENT || epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) == -1)
+                {
+                    throw std::system_error(errno, std::system_category());
+                }
+            }
+        }
+
+        // Blocks until at least one file descriptor is ready. Returns false once stop has been called.
+        template <typename Post>
+        bool run_once(Post&& post)
+        {
+            std::array<epoll_event, 64> events;
+            int const count = epoll_wait(m_epoll, events.data(), static_cast<int>(events.size()), -1);
+
+            for (int i = 0; i < count; ++i)
+            {
+                auto value = static_cast<registration*>(events[i].data.ptr);
+
+                if (!value)
+                {
+                    return false;
+                }
+
+                value->events = events[i].events;
+                post(value);
+            }
+
+            return true;
+        }
+
+        void stop() noexcept
+        {
+            uint64_t const value = 1;
+            static_cast<void>(::write(m_wake, &value, sizeof(value)));
+        }
+
+    private:
+
+        int m_epoll{ -1 };
+        int m_wake{ -1 };
+    };
+#endif
+}
+
+namespace xlang
+{
+    // A portable pool of worker threads that coroutines and callbacks can be scheduled on. Work is
+    // spread across per-thread queues and idle workers steal from busy ones. Timers are kept on a
+    // timer wheel serviced by a single thread, and on Linux an epoll reactor waits on file
+    // descriptors. Neither thread is created until it is first needed.
+    struct executor
+    {
+        explicit executor(uint32_t thread_count = 0) :
+            m_timers(impl::timer_wheel::clock::now())
+        {
+            if (thread_count == 0)
+            {
+                thread_count = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            m_queues = std::make_unique<impl::executor_queue[]>(thread_count);
+            m_workers.reserve(thread_count);
+
+            try
+            {
+                for (uint32_t index = 0; index < thread_count; ++index)
+                {
+                    m_workers.emplace_back([this, index] { run_worker(index); });
+                }
+            }
+            catch (...)
+            {
+                shutdown();
+                throw;
+            }
+        }
+
+        executor(executor const&) = delete;
+        executor& operator=(executor const&) = delete;
+
+        // Work that is already queued still runs. Timers and I/O waits that haven't fired are abandoned.
+        ~executor() noexcept
+        {
+            shutdown();
+        }
+
+        // The executor backing resume_background and resume_after.
+        static executor& background()
+        {
+            static executor value;
+            return value;
+        }
+
+        // The executor whose worker is running the calling thread, if any.
+        static executor* current() noexcept
+        {
+            return current_worker().owner;
+        }
+
+        uint32_t thread_count() const noexcept
+        {
+            return static_cast<uint32_t>(m_workers.size());
+        }
+
+        void post(void(*callback)(void* context), void* context)
+        {
+            impl::executor_work const work{ callback, context };
+            auto const& worker = current_worker();
+
+            if (worker.owner == this)
+            {
+                m_queues[worker.index].push(work);
+            }
+            else
+            {
+                m_queues[m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size()].push(work);
+            }
+
+            ++m_pending;
+
+            if (m_sleeping > 0)
+            {
+                std::lock_guard const guard(m_idle_lock);
+                m_idle.notify_one();
+            }
+        }
+
+        template <typename F>
+        void post(F&& function)
+        {
+            using function_type = std::decay_t<F>;
+            auto value = std::make_unique<function_type>(std::forward<F>(function));
+            post(impl::invoke_executor_function<function_type>, value.get());
+            value.release();
+        }
+
+        void post_after(Foundation::TimeSpan delay, void(*callback)(void* context), void* context)
+        {
+            auto const due = impl::timer_wheel::clock::now() + std::chrono::duration_cast<impl::timer_wheel::clock::duration>(delay);
+
+            {
+                std::lock_guard const guard(m_timer_lock);
+
+                if (!m_timer_thread.joinable() && !m_timers_stopping)
+                {
+                    m_timer_thread = std::thread([this] { run_timers(); });
+                }
+
+                m_timers.add(due, { callback, context });
+            }
+
+            m_timer_changed.notify_one();
+        }
+
+        template <typename F>
+        void post_after(Foundation::TimeSpan delay, F&& function)
+        {
+            using function_type = std::decay_t<F>;
+            auto value = std::make_unique<function_type>(std::forward<F>(function));
+            post_after(delay, impl::invoke_executor_function<function_type>, value.get());
+            value.release();
+        }
+
+#ifdef __linux__
+        // Calls back on the executor once fd reports any of the requested epoll events. The callback
+        // receives the events that were reported.
+        void post_on_ready(int fd, uint32_t events, void(*callback)(void* context, uint32_t events), void* context)
+        {
+            {
+                std::lock_guard const guard(m_reactor_lock);
+
+                if (!m_reactor)
+                {
+                    m_reactor = std::make_unique<impl::executor_reactor>();
+                    m_reactor_thread = std::thread([this] { run_reactor(); });
+                }
+            }
+
+            auto value = std::make_unique<impl::executor_reactor::registration>(impl::executor_reactor::registration{ callback, context, 0 });
+            m_reactor->add(fd, events, value.get());
+            value.release();
+        }
+#endif
+
+    private:
+
+        struct worker_info
+        {
+            executor* owner;
+            uint32_t index;
+        };
+
+        static worker_info& current_worker() noexcept
+        {
+            static thread_local worker_info value{};
+            return value;
+        }
+
+        void run_worker(uint32_t index) noexcept
+        {
+            current_worker() = { this, index };
+            impl::executor_work work{};
+
+            while (true)
+            {
+                if (try_take(index, work))
+                {
+                    work.callback(work.context);
+                    continue;
+                }
+
+                std::unique_lock guard(m_idle_lock);
+                ++m_sleeping;
+                m_idle.wait(guard, [&] { return m_pending > 0 || m_stopping; });
+                --m_sleeping;
+
+                if (m_pending == 0 && m_stopping)
+                {
+                    return;
+                }
+            }
+        }
+
+        bool try_take(uint32_t index, impl::executor_work& work) noexcept
+        {
+            if (m_pending == 0)
+            {
+                return false;
+            }
+
+            bool found = m_queues[index].pop(work);
+
+            for (size_t offset = 1; !found && offset != m_workers.size(); ++offset)
+            {
+                found = m_queues[(index + offset) % m_workers.size()].steal(work);
+            }
+
+            if (found)
+            {
+                --m_pending;
+            }
+
+            return found;
+        }
+
+        void run_timers() noexcept
+        {
+            std::vector<impl::executor_work> ready;
+            std::unique_lock guard(m_timer_lock);
+
+            while (!m_timers_stopping)
+            {
+                auto const next = m_timers.advance(impl::timer_wheel::clock::now(), ready);
+
+                if (!ready.empty())
+                {
+                    guard.unlock();
+
+                    for (auto&& work : ready)
+                    {
+                        post(work.callback, work.context);
+                    }
+
+                    ready.clear();
+                    guard.lock();
+                    continue;
+                }
+
+                if (next)
+                {
+                    m_timer_changed.wait_until(guard, *next);
+                }
+                else
+                {
+                    m_timer_changed.wait(guard);
+                }
+            }
+        }
+
+#ifdef __linux__
+        void run_reactor() noexcept
+        {
+            auto post_registration = [this](impl::executor_reactor::registration* value)
+            {
+                post([](void* context)
+                {
+                    std::unique_ptr<impl::executor_reactor::registration> value{ static_cast<impl::executor_reactor::registration*>(context) };
+                    value->callback(value->context, value->events);
+                }, value);
+            };
+
+            while (m_reactor->run_once(post_registration))
+            {
+            }
+        }
+#endif
+
+        void shutdown() noexcept
+        {
+            {
+                std::lock_guard const guard(m_timer_lock);
+                m_timers_stopping = true;
+            }
+
+            m_timer_changed.notify_one();
+
+            if (m_timer_thread.joinable())
+            {
+                m_timer_thread.join();
+            }
+
+#ifdef __linux__
+            if (m_reactor)
+            {
+                m_reactor->stop();
+                m_reactor_thread.join();
+            }
+#endif
+
+            {
+                std::lock_guard const guard(m_idle_lock);
+                m_stopping = true;
+            }
+
+            m_idle.notify_all();
+
+            for (auto&& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        std::unique_ptr<impl::executor_queue[]> m_queues;
+        std::vector<std::thread> m_workers;
+        std::atomic<size_t> m_next{};
+        std::atomic<size_t> m_pending{};
+        std::atomic<uint32_t> m_sleeping{};
+        std::mutex m_idle_lock;
+        std::condition_variable m_idle;
+        bool m_stopping{};
+
+        std::mutex m_timer_lock;
+        std::condition_variable m_timer_changed;
+        impl::timer_wheel m_timers;
+        std::thread m_timer_thread;
+        bool m_timers_stopping{};
+
+#ifdef __linux__
+        std::mutex m_reactor_lock;
+        std::unique_ptr<impl::executor_reactor> m_reactor;
+        std::thread m_reactor_thread;
+#endif
+    };
+}
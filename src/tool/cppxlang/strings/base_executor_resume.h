@@ -0,0 +1,170 @@
+
+#if defined(_RESUMABLE_FUNCTIONS_SUPPORTED) || defined(__cpp_coroutines)
+
+#include <experimental/coroutine>
+
+namespace xlang::impl
+{
+    inline void resume_coroutine(void* address)
+    {
+        std::experimental::coroutine_handle<>::from_address(address)();
+    }
+
+#ifndef _WIN32
+    // Resumes on the executor the coroutine was running on, or the background executor if it wasn't
+    // running on one, rather than on the thread that completes the async operation.
+    template <typename Async>
+    void resume_on_completed(Async const& async, std::experimental::coroutine_handle<> handle)
+    {
+        executor* context = executor::current();
+
+        if (!context)
+        {
+            context = &executor::background();
+        }
+
+        async.Completed([handle, context](auto const&, auto const&)
+        {
+            context->post(resume_coroutine, handle.address());
+        });
+    }
+#endif
+}
+
+namespace xlang
+{
+    [[nodiscard]] inline auto resume_on(executor& context) noexcept
+    {
+        struct awaitable
+        {
+            explicit awaitable(executor& context) noexcept :
+                m_context(context)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+            void await_suspend(std::experimental::coroutine_handle<> handle) const
+            {
+                m_context.post(impl::resume_coroutine, handle.address());
+            }
+
+        private:
+
+            executor& m_context;
+        };
+
+        return awaitable{ context };
+    }
+
+    [[nodiscard]] inline auto resume_after(executor& context, Foundation::TimeSpan duration) noexcept
+    {
+        struct awaitable
+        {
+            awaitable(executor& context, Foundation::TimeSpan duration) noexcept :
+                m_context(context),
+                m_duration(duration)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return m_duration.count() <= 0;
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+            void await_suspend(std::experimental::coroutine_handle<> handle) const
+            {
+                m_context.post_after(m_duration, impl::resume_coroutine, handle.address());
+            }
+
+        private:
+
+            executor& m_context;
+            Foundation::TimeSpan m_duration;
+        };
+
+        return awaitable{ context, duration };
+    }
+
+#ifdef __linux__
+    // Resumes on the executor once fd reports any of the requested epoll events, and returns the
+    // events that were reported.
+    [[nodiscard]] inline auto resume_on_ready(executor& context, int fd, uint32_t events) noexcept
+    {
+        struct awaitable
+        {
+            awaitable(executor& context, int fd, uint32_t events) noexcept :
+                m_context(context),
+                m_fd(fd),
+                m_events(events)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            uint32_t await_resume() const noexcept
+            {
+                return m_events;
+            }
+
+            void await_suspend(std::experimental::coroutine_handle<> handle)
+            {
+                m_resume = handle;
+                m_context.post_on_ready(m_fd, m_events, callback, this);
+            }
+
+        private:
+
+            static void callback(void* context, uint32_t events)
+            {
+                auto that = static_cast<awaitable*>(context);
+                that->m_events = events;
+                that->m_resume();
+            }
+
+            executor& m_context;
+            int m_fd;
+            uint32_t m_events;
+            std::experimental::coroutine_handle<> m_resume{ nullptr };
+        };
+
+        return awaitable{ context, fd, events };
+    }
+#endif
+}
+
+#ifndef _WIN32
+namespace xlang
+{
+    [[nodiscard]] inline auto resume_background()
+    {
+        return resume_on(executor::background());
+    }
+
+    [[nodiscard]] inline auto resume_after(Foundation::TimeSpan duration)
+    {
+        return resume_after(executor::background(), duration);
+    }
+
+    inline auto operator co_await(Foundation::TimeSpan duration)
+    {
+        return resume_after(duration);
+    }
+}
+#endif
+
+#endif
@@ -15,6 +15,8 @@ namespace xlang
     struct composable : impl::marker {};
     struct no_module_lock : impl::marker {};
     struct static_lifetime : impl::marker {};
+    struct pooled : impl::marker {};
+    struct inline_weak_ref : impl::marker {};
 
     template <typename Interface>
     struct cloaked : Interface {};
@@ -187,6 +189,18 @@ namespace xlang::impl
     template <typename D>
     inline constexpr bool has_static_lifetime_v = has_static_lifetime<typename D::implements_type>::value;
 
+    template <typename>
+    struct is_pooled : std::false_type {};
+
+    template <typename D, typename... I>
+    struct is_pooled<implements<D, I...>> : std::disjunction<std::is_same<pooled, I>...> {};
+
+    template <typename>
+    struct has_inline_weak_ref : std::false_type {};
+
+    template <typename D, typename... I>
+    struct has_inline_weak_ref<implements<D, I...>> : std::disjunction<std::is_same<inline_weak_ref, I>...> {};
+
     template <typename T>
     void clear_abi(T*) noexcept
     {}
@@ -349,21 +363,178 @@ namespace xlang::impl
         using type = typename implements_default_interface<T>::type;
     };
 
-    struct iid_finder
+    // QueryInterface finds an implemented interface through a perfect hash of the interface IDs that
+    // is built at compile time for each implementation. Each IID is folded into 64 bits and multiplied
+    // by a seed chosen so that no two implemented interfaces land in the same slot. A lookup then costs
+    // one multiply and one GUID compare, however many interfaces the class implements.
+    constexpr uint64_t fold_guid(guid const& value) noexcept
     {
-        const guid& m_guid;
+        uint64_t data4{};
 
-        template <typename I>
-        constexpr bool test() const noexcept
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            data4 |= static_cast<uint64_t>(value.Data4[i]) << (i * 8);
+        }
+
+        return (value.Data1 | static_cast<uint64_t>(value.Data2) << 32 | static_cast<uint64_t>(value.Data3) << 48) ^ data4;
+    }
+
+    constexpr bool guid_equal(guid const& left, guid const& right) noexcept
+    {
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            if (left.Data4[i] != right.Data4[i])
+            {
+                return false;
+            }
+        }
+
+        return left.Data1 == right.Data1 && left.Data2 == right.Data2 && left.Data3 == right.Data3;
+    }
+
+    struct iid_hash_params
+    {
+        bool valid;
+        uint32_t bits;
+        uint64_t seed;
+    };
+
+    constexpr uint32_t iid_hash_slot(uint64_t const key, uint64_t const seed, uint32_t const bits) noexcept
+    {
+        return bits == 0 ? 0 : static_cast<uint32_t>((key * seed) >> (64 - bits));
+    }
+
+    // Searches for a seed that maps every distinct IID to its own slot, starting with a table of at
+    // least twice as many slots as interfaces. An interface listed more than once only needs its first
+    // occurrence to be found, as with a linear search. The result is invalid if two different IIDs
+    // fold to the same key, in which case the caller falls back to a linear search.
+    template <size_t Count>
+    constexpr iid_hash_params make_iid_hash_params(std::array<guid, Count> const& iids) noexcept
+    {
+        std::array<uint64_t, Count> keys{};
+        std::array<bool, Count> duplicate{};
+
+        for (size_t i = 0; i < Count; ++i)
+        {
+            keys[i] = fold_guid(iids[i]);
+
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (keys[i] == keys[j])
+                {
+                    if (!guid_equal(iids[i], iids[j]))
+                    {
+                        return {};
+                    }
+
+                    duplicate[i] = true;
+                }
+            }
+        }
+
+        uint32_t bits = 1;
+
+        while ((size_t{ 1 } << bits) < Count * 2)
+        {
+            ++bits;
+        }
+
+        for (; bits <= 12; ++bits)
+        {
+            uint64_t state = 0x9E3779B97F4A7C15;
+
+            for (uint32_t attempt = 0; attempt < 256; ++attempt)
+            {
+                state += 0x9E3779B97F4A7C15;
+                uint64_t const seed = (state ^ (state >> 31)) | 1;
+                std::array<uint32_t, Count> slots{};
+                bool perfect = true;
+
+                for (size_t i = 0; i < Count && perfect; ++i)
+                {
+                    slots[i] = iid_hash_slot(keys[i], seed, bits);
+
+                    for (size_t j = 0; j < i && perfect && !duplicate[i]; ++j)
+                    {
+                        perfect = duplicate[j] || slots[i] != slots[j];
+                    }
+                }
+
+                if (perfect)
+                {
+                    return { true, bits, seed };
+                }
+            }
+        }
+
+        return {};
+    }
+
+    template <typename T, typename I>
+    void* find_implemented_interface(const T* obj) noexcept
+    {
+        return to_abi<I>(obj);
+    }
+
+    template <typename T, typename List>
+    struct iid_table;
+
+    template <typename T, typename... I>
+    struct iid_table<T, interface_list<I...>>
+    {
+        static constexpr size_t count = sizeof...(I);
+        static constexpr std::array<guid, count> iids{ guid_of<I>()... };
+        static constexpr std::array<void* (*)(const T*) noexcept, count> interfaces{ &find_implemented_interface<T, I>... };
+        static constexpr iid_hash_params params = make_iid_hash_params(iids);
+
+        // Holds one more than the index of the interface in each slot, or zero for an empty slot.
+        static constexpr auto slots = []() noexcept
+        {
+            std::array<uint8_t, size_t{ 1 } << (params.valid ? params.bits : 0)> result{};
+
+            if constexpr (params.valid)
+            {
+                for (size_t i = count; i != 0; --i)
+                {
+                    result[iid_hash_slot(fold_guid(iids[i - 1]), params.seed, params.bits)] = static_cast<uint8_t>(i);
+                }
+            }
+
+            return result;
+        }();
+
+        static_assert(count < 256, "Too many implemented interfaces");
+
+        static void* find(const T* obj, guid const& iid) noexcept
         {
-            return is_guid_of<typename default_interface<I>::type>(m_guid);
+            if constexpr (params.valid)
+            {
+                uint32_t const slot = slots[iid_hash_slot(fold_guid(iid), params.seed, params.bits)];
+
+                if (slot != 0 && iids[slot - 1] == iid)
+                {
+                    return interfaces[slot - 1](obj);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (iids[i] == iid)
+                    {
+                        return interfaces[i](obj);
+                    }
+                }
+            }
+
+            return nullptr;
         }
     };
 
     template <typename T>
     auto find_iid(const T* obj, const guid& iid) noexcept
     {
-        return static_cast<unknown_abi*>(implemented_interfaces<T>::find(obj, iid_finder{ iid }));
+        return static_cast<unknown_abi*>(iid_table<T, implemented_interfaces<T>>::find(obj, iid));
     }
 
     struct xlang_object_finder
@@ -502,18 +673,15 @@ namespace xlang::impl
         }
     };
 
-    template <bool Agile>
-    struct weak_ref;
-
-    template <bool Agile>
+    template <typename Owner>
     struct weak_source_producer;
 
-    template <bool Agile>
+    template <typename Owner>
     struct weak_source : IWeakReferenceSource
     {
-        weak_ref<Agile>* that() noexcept
+        Owner* that() noexcept
         {
-            return static_cast<weak_ref<Agile>*>(reinterpret_cast<weak_source_producer<Agile>*>(this));
+            return static_cast<Owner*>(reinterpret_cast<weak_source_producer<Owner>*>(this));
         }
 
         com_interop_result XLANG_CALL QueryInterface(guid const& id, void** object) noexcept override
@@ -525,7 +693,7 @@ namespace xlang::impl
                 return com_interop_result::success;
             }
 
-            return that()->m_object->QueryInterface(id, object);
+            return that()->get_object()->QueryInterface(id, object);
         }
 
         uint32_t XLANG_CALL AddRef() noexcept override
@@ -535,7 +703,7 @@ namespace xlang::impl
 
         uint32_t XLANG_CALL Release() noexcept override
         {
-            return that()->m_object->Release();
+            return that()->get_object()->Release();
         }
 
         com_interop_result XLANG_CALL GetWeakReference(IWeakReference** weakReference) noexcept override
@@ -546,15 +714,15 @@ namespace xlang::impl
         }
     };
 
-    template <bool Agile>
+    template <typename Owner>
     struct weak_source_producer
     {
     protected:
-        weak_source<Agile> m_source;
+        weak_source<Owner> m_source;
     };
 
     template <bool Agile>
-    struct weak_ref : IWeakReference, weak_source_producer<Agile>
+    struct weak_ref : IWeakReference, weak_source_producer<weak_ref<Agile>>
     {
         weak_ref(unknown_abi* object, uint32_t const strong) noexcept :
             m_object(object),
@@ -642,17 +810,180 @@ namespace xlang::impl
             return &this->m_source;
         }
 
-    private:
-        template <bool T>
-        friend struct weak_source;
+        unknown_abi* get_object() const noexcept
+        {
+            return m_object;
+        }
 
-        static_assert(sizeof(weak_source_producer<Agile>) == sizeof(weak_source<Agile>));
+    private:
+        static_assert(sizeof(weak_source_producer<weak_ref>) == sizeof(weak_source<weak_ref>));
 
         unknown_abi* m_object{};
         std::atomic<uint32_t> m_strong{ 1 };
         std::atomic<uint32_t> m_weak{ 1 };
     };
 
+    template <typename T, typename = void>
+    struct heap_implements;
+
+    // The weak reference control block of an implementation marked with xlang::inline_weak_ref. It is
+    // placed immediately before the object, in the same allocation, and its strong count is the object's
+    // reference count. Taking a weak reference therefore allocates nothing and never changes how the
+    // object counts references. The storage is freed once the object has been destroyed and the last
+    // weak reference has been released. heap_implements<D> begins with its D base, so the block is found
+    // from either D or the block without knowing the rest of the layout.
+    template <typename D>
+    struct weak_ref_block final : IWeakReference, weak_source_producer<weak_ref_block<D>>
+    {
+        // Set while the object is being destroyed, so that weak references can no longer resolve.
+        static constexpr uint32_t destroying = 0x80000000;
+
+        explicit weak_ref_block(size_t const allocation_size) noexcept :
+            m_allocation_size(allocation_size)
+        {
+        }
+
+        static constexpr size_t header_size() noexcept
+        {
+            constexpr size_t alignment = alignof(std::max_align_t);
+            return (sizeof(weak_ref_block) + alignment - 1) & ~(alignment - 1);
+        }
+
+        static weak_ref_block* from_object(D* object) noexcept
+        {
+            return reinterpret_cast<weak_ref_block*>(reinterpret_cast<char*>(object) - header_size());
+        }
+
+        com_interop_result XLANG_CALL QueryInterface(guid const& id, void** object) noexcept override
+        {
+            if (is_guid_of<IWeakReference>(id) || is_guid_of<Windows::Foundation::IUnknown>(id))
+            {
+                *object = static_cast<IWeakReference*>(this);
+                AddRef();
+                return com_interop_result::success;
+            }
+
+            *object = nullptr;
+            return com_interop_result::no_interface;
+        }
+
+        uint32_t XLANG_CALL AddRef() noexcept override
+        {
+            return 1 + m_weak.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint32_t XLANG_CALL Release() noexcept override
+        {
+            uint32_t const target = m_weak.fetch_sub(1, std::memory_order_release) - 1;
+
+            if (target == 0)
+            {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                size_t const size = m_allocation_size;
+                this->~weak_ref_block();
+
+                if constexpr (is_pooled<typename D::implements_type>::value)
+                {
+                    pool_deallocate(this, size);
+                }
+                else
+                {
+                    ::operator delete(static_cast<void*>(this));
+                }
+            }
+
+            return target;
+        }
+
+        com_interop_result XLANG_CALL Resolve(guid const& id, void** objectReference) noexcept override
+        {
+            uint32_t target = m_strong.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                if (target == 0 || (target & destroying))
+                {
+                    *objectReference = nullptr;
+                    return com_interop_result::success;
+                }
+
+                if (m_strong.compare_exchange_weak(target, target + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    unknown_abi* const object = get_object();
+                    com_interop_result hr = object->QueryInterface(id, objectReference);
+                    object->Release();
+                    return hr;
+                }
+            }
+        }
+
+        uint32_t increment_strong() noexcept
+        {
+            return 1 + m_strong.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Acquires on every release so that the thread that destroys the object sees all prior writes.
+        uint32_t decrement_strong() noexcept
+        {
+            return m_strong.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        }
+
+        // Keeps references taken while the object is destroyed from destroying it again.
+        void begin_destruction() noexcept
+        {
+            m_strong.store(destroying | 1, std::memory_order_relaxed);
+        }
+
+        IWeakReferenceSource* get_source() noexcept
+        {
+            increment_strong();
+            return &this->m_source;
+        }
+
+        unknown_abi* get_object() noexcept
+        {
+            using I = typename implements_default_interface<D>::type;
+            return reinterpret_cast<unknown_abi*>(to_abi<I>(reinterpret_cast<D*>(reinterpret_cast<char*>(this) + header_size())));
+        }
+
+    private:
+
+        size_t const m_allocation_size;
+        std::atomic<uint32_t> m_strong{ 1 };
+        std::atomic<uint32_t> m_weak{ 1 };
+    };
+
+    // Places a weak_ref_block in front of each object of the derived class.
+    template <typename D>
+    struct inline_weak_ref_allocation
+    {
+        static void* operator new(size_t const size)
+        {
+            static_assert(alignof(D) <= alignof(std::max_align_t), "inline_weak_ref does not support over-aligned types.");
+            using block_type = weak_ref_block<D>;
+            size_t const allocation_size = block_type::header_size() + size;
+            void* raw;
+
+            if constexpr (is_pooled<typename D::implements_type>::value)
+            {
+                raw = pool_allocate(allocation_size);
+            }
+            else
+            {
+                raw = ::operator new(allocation_size);
+            }
+
+            new (raw) block_type(allocation_size);
+            return static_cast<char*>(raw) + block_type::header_size();
+        }
+
+        // Releases the weak count that the object holds on its block.
+        static void operator delete(void* const pointer) noexcept
+        {
+            weak_ref_block<D>::from_object(static_cast<D*>(pointer))->Release();
+        }
+    };
+
     template <bool>
     struct XLANG_EBO root_implements_composing_outer
     {
@@ -789,7 +1120,11 @@ namespace xlang::impl
         virtual ~root_implements() noexcept
         {
             // If a weak reference is created during destruction, this ensures that it is also destroyed.
-            subtract_reference();
+            // An inline weak reference block is released along with the object's storage instead.
+            if constexpr (!is_inline_weak_ref::value)
+            {
+                subtract_reference();
+            }
 
             if constexpr (use_module_lock::value)
             {
@@ -817,7 +1152,11 @@ namespace xlang::impl
 
         uint32_t XLANG_CALL NonDelegatingAddRef() noexcept
         {
-            if constexpr (is_weak_ref_source::value)
+            if constexpr (is_inline_weak_ref::value)
+            {
+                return get_weak_ref_block()->increment_strong();
+            }
+            else if constexpr (is_weak_ref_source::value)
             {
                 uintptr_t count_or_pointer = m_references.load(std::memory_order_relaxed);
 
@@ -850,7 +1189,14 @@ namespace xlang::impl
             {
                 // If a weak reference was previously created, the m_references value will not be stable value (won't be zero).
                 // This ensures destruction has a stable value during destruction.
-                m_references = 1;
+                if constexpr (is_inline_weak_ref::value)
+                {
+                    get_weak_ref_block()->begin_destruction();
+                }
+                else
+                {
+                    m_references = 1;
+                }
 
                 D::final_release(std::unique_ptr<D>(static_cast<D*>(this)));
             }
@@ -918,7 +1264,11 @@ namespace xlang::impl
 
         uint32_t subtract_reference() noexcept
         {
-            if constexpr (is_weak_ref_source::value)
+            if constexpr (is_inline_weak_ref::value)
+            {
+                return get_weak_ref_block()->decrement_strong();
+            }
+            else if constexpr (is_weak_ref_source::value)
             {
                 uintptr_t count_or_pointer = m_references.load(std::memory_order_relaxed);
 
@@ -967,8 +1317,12 @@ namespace xlang::impl
         using is_xlang_object = std::disjunction<std::is_base_of<Windows::Foundation::IXlangObject, I>...>;
         using is_weak_ref_source = std::conjunction<is_xlang_object, std::negation<is_factory>, std::negation<std::disjunction<std::is_same<no_weak_ref, I>...>>>;
         using use_module_lock = std::negation<std::disjunction<std::is_same<no_module_lock, I>...>>;
+        using is_inline_weak_ref = std::disjunction<std::is_same<inline_weak_ref, I>...>;
         using weak_ref_t = impl::weak_ref<is_agile::value>;
 
+        static_assert(!is_inline_weak_ref::value || is_weak_ref_source::value, "inline_weak_ref requires weak reference support.");
+
+        // Implementations marked with inline_weak_ref count their references in their weak_ref_block instead.
         std::atomic<std::conditional_t<is_weak_ref_source::value, uintptr_t, uint32_t>> m_references{ 1 };
 
         com_interop_result query_interface(guid const& id, void** object) noexcept
@@ -1023,6 +1377,12 @@ namespace xlang::impl
         impl::IWeakReferenceSource* make_weak_ref() noexcept
         {
             static_assert(is_weak_ref_source::value, "This is only for weak ref support.");
+
+            if constexpr (is_inline_weak_ref::value)
+            {
+                return get_weak_ref_block()->get_source();
+            }
+
             uintptr_t count_or_pointer = m_references.load(std::memory_order_relaxed);
 
             if (is_weak_ref(count_or_pointer))
@@ -1058,6 +1418,12 @@ namespace xlang::impl
             }
         }
 
+        impl::weak_ref_block<D>* get_weak_ref_block() noexcept
+        {
+            static_assert(is_inline_weak_ref::value, "This is only for inline weak ref support.");
+            return impl::weak_ref_block<D>::from_object(static_cast<D*>(this));
+        }
+
         static bool is_weak_ref(intptr_t const value) noexcept
         {
             static_assert(is_weak_ref_source::value, "This is only for weak ref support.");
@@ -1096,11 +1462,28 @@ namespace xlang::impl
         friend struct impl::produce;
     };
 
-    template <typename T>
+    template <typename T, typename>
     struct heap_implements final : T
     {
         using T::T;
 
+#ifdef _DEBUG
+        void use_make_function_to_create_this_object() final
+        {
+        }
+#endif
+    };
+
+    // Implementations marked with xlang::pooled take their storage from the per-thread pool, or from
+    // the allocation hooks if they are installed. Release frees them the same way. Implementations
+    // marked with xlang::inline_weak_ref allocate their weak reference control block along with them.
+    template <typename T>
+    struct heap_implements<T, std::enable_if_t<is_pooled<typename T::implements_type>::value || has_inline_weak_ref<typename T::implements_type>::value>> final :
+        T,
+        std::conditional_t<has_inline_weak_ref<typename T::implements_type>::value, inline_weak_ref_allocation<T>, pooled_allocation>
+    {
+        using T::T;
+
 #ifdef _DEBUG
         void use_make_function_to_create_this_object() final
         {
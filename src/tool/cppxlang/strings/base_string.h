@@ -441,76 +441,196 @@ namespace xlang::impl
     };
 }
 
+namespace xlang::impl
+{
+    // Produces the same text as the printf-based conversions these replaced, without the format string
+    // and locale handling, and with the length known before the string is allocated.
+    struct format_buffer
+    {
+        char const* data() const noexcept
+        {
+            return m_data;
+        }
+
+        uint32_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        char m_data[40];
+        uint32_t m_size;
+    };
+
+    template <typename T>
+    inline constexpr bool is_formatted_integer_v = std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+        !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t> && !std::is_same_v<T, xlang_char8>;
+
+    template <typename T>
+    uint32_t decimal_length(T const value) noexcept
+    {
+        auto magnitude = static_cast<std::make_unsigned_t<T>>(value);
+        uint32_t length = 1;
+
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (value < 0)
+            {
+                magnitude = static_cast<std::make_unsigned_t<T>>(0 - magnitude);
+                ++length;
+            }
+        }
+
+        while (magnitude >= 10)
+        {
+            magnitude /= 10;
+            ++length;
+        }
+
+        return length;
+    }
+
+    template <typename T>
+    format_buffer format_integer(T const value) noexcept
+    {
+        format_buffer result;
+        result.m_size = static_cast<uint32_t>(std::to_chars(result.m_data, std::end(result.m_data), value).ptr - result.m_data);
+        return result;
+    }
+
+    // Matches printf's "%G".
+    inline format_buffer format_floating(double const value) noexcept
+    {
+        format_buffer result;
+#ifdef __cpp_lib_to_chars
+        result.m_size = static_cast<uint32_t>(std::to_chars(result.m_data, std::end(result.m_data), value, std::chars_format::general, 6).ptr - result.m_data);
+
+        for (uint32_t index = 0; index < result.m_size; ++index)
+        {
+            if (result.m_data[index] >= 'a' && result.m_data[index] <= 'z')
+            {
+                result.m_data[index] -= 'a' - 'A';
+            }
+        }
+#else
+        result.m_size = static_cast<uint32_t>(snprintf(result.m_data, std::size(result.m_data), "%G", value));
+#endif
+        return result;
+    }
+
+    inline constexpr uint32_t guid_string_length = 38;
+
+    // Writes {00000000-0000-0000-0000-000000000000} in lowercase hexadecimal.
+    template <typename Char>
+    Char* write_guid(guid const& value, Char* cursor) noexcept
+    {
+        constexpr char digits[] = "0123456789abcdef";
+
+        auto write_hex = [&](uint64_t const number, uint32_t const count)
+        {
+            for (uint32_t index = count; index != 0; --index)
+            {
+                *cursor++ = static_cast<Char>(digits[(number >> ((index - 1) * 4)) & 0xF]);
+            }
+        };
+
+        *cursor++ = static_cast<Char>('{');
+        write_hex(value.Data1, 8);
+        *cursor++ = static_cast<Char>('-');
+        write_hex(value.Data2, 4);
+        *cursor++ = static_cast<Char>('-');
+        write_hex(value.Data3, 4);
+        *cursor++ = static_cast<Char>('-');
+        write_hex(value.Data4[0], 2);
+        write_hex(value.Data4[1], 2);
+        *cursor++ = static_cast<Char>('-');
+
+        for (uint32_t index = 2; index < 8; ++index)
+        {
+            write_hex(value.Data4[index], 2);
+        }
+
+        *cursor++ = static_cast<Char>('}');
+        return cursor;
+    }
+
+    inline format_buffer format_guid(guid const& value) noexcept
+    {
+        format_buffer result;
+        result.m_size = static_cast<uint32_t>(write_guid(value, result.m_data) - result.m_data);
+        return result;
+    }
+
+    template <typename T>
+    hstring integer_to_hstring(T const value)
+    {
+        uint32_t const size = decimal_length(value);
+        hstring_builder text(size);
+        auto const first = reinterpret_cast<char*>(text.data());
+        std::to_chars(first, first + size, value);
+        return text.to_hstring();
+    }
+
+    template <typename Char>
+    hstring copy_to_hstring(Char const* data, uint32_t const size)
+    {
+        hstring_builder text(size);
+        std::copy_n(data, size, text.data());
+        return text.to_hstring();
+    }
+}
+
 namespace xlang
 {
     inline hstring to_hstring(uint8_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRIu8, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(int8_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRId8, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(uint16_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRIu16, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(int16_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRId16, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(uint32_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRIu32, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(int32_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRId32, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(uint64_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRIu64, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(int64_t value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%" PRId64, value);
-        return hstring{ buffer };
+        return impl::integer_to_hstring(value);
     }
 
     inline hstring to_hstring(float value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%G", value);
-        return hstring{ buffer };
+        auto const text = impl::format_floating(value);
+        return impl::copy_to_hstring(text.data(), text.size());
     }
 
     inline hstring to_hstring(double value)
     {
-        char buffer[32];
-        snprintf(buffer, std::size(buffer), "%G", value);
-        return hstring{ buffer };
+        auto const text = impl::format_floating(value);
+        return impl::copy_to_hstring(text.data(), text.size());
     }
 
     inline hstring to_hstring(char16_t value)
@@ -539,12 +659,9 @@ namespace xlang
 
     inline hstring to_hstring(guid const& value)
     {
-        char buffer[40];
-        //{00000000-0000-0000-0000-000000000000}
-        snprintf(buffer, std::size(buffer), "{%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx}",
-            value.Data1, value.Data2, value.Data3, value.Data4[0], value.Data4[1],
-            value.Data4[2], value.Data4[3], value.Data4[4], value.Data4[5], value.Data4[6], value.Data4[7]);
-        return hstring{ buffer };
+        impl::hstring_builder text(impl::guid_string_length);
+        impl::write_guid(value, text.data());
+        return text.to_hstring();
     }
 
     template <typename T, typename = std::enable_if_t<std::is_convertible_v<T, std::string_view>>>
@@ -554,3 +671,66 @@ namespace xlang
         return hstring{ view };
     }
 }
+
+namespace xlang::impl
+{
+    // Returns a view of the argument's text, or an object that holds it, for format_hstring.
+    template <typename T>
+    auto format_argument(T const& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return std::string_view(value ? "true" : "false");
+        }
+        else if constexpr (std::is_same_v<T, guid>)
+        {
+            return format_guid(value);
+        }
+        else if constexpr (is_formatted_integer_v<T>)
+        {
+            return format_integer(value);
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return format_floating(value);
+        }
+        else if constexpr (std::is_convertible_v<T const&, std::basic_string_view<xlang_char8>>)
+        {
+            return std::basic_string_view<xlang_char8>(value);
+        }
+        else if constexpr (std::is_convertible_v<T const&, std::string_view>)
+        {
+            return std::string_view(value);
+        }
+        else
+        {
+            return to_hstring(value);
+        }
+    }
+}
+
+namespace xlang
+{
+    // Concatenates the text of each argument, as to_hstring would produce it, with a single string
+    // allocation. For example, format_hstring(u8"id=", 42, u8" iid=", guid_of<T>()).
+    template <typename... Args>
+    hstring format_hstring(Args const&... args)
+    {
+        auto const parts = std::make_tuple(impl::format_argument(args)...);
+
+        return std::apply([](auto const&... part)
+        {
+            size_t const size = (size_t{} + ... + part.size());
+
+            if (size == 0)
+            {
+                return hstring{};
+            }
+
+            impl::hstring_builder text(static_cast<uint32_t>(size));
+            auto cursor = text.data();
+            ((cursor = std::copy_n(part.data(), part.size(), cursor)), ...);
+            return text.to_hstring();
+        }, parts);
+    }
+}
@@ -32,6 +32,12 @@ namespace xlang
             {
                 impl::com_ref<default_interface<T>> temp;
                 m_ref->Resolve(guid_of<T>(), put_abi(temp));
+
+                if (!temp)
+                {
+                    return nullptr;
+                }
+
                 void* result = get_self<T>(temp);
                 detach_abi(temp);
                 return { result, take_ownership_from_abi };
@@ -0,0 +1,162 @@
+#include "pch.h"
+#include "merger.h"
+
+namespace xlang
+{
+    using namespace text;
+
+    struct usage_exception {};
+
+    struct writer : writer_base<writer>
+    {
+    };
+
+    static constexpr cmd::option options[]
+    {
+        { "input", 1, cmd::option::no_max, "<spec>", "Metadata to merge" },
+        { "output", 1, 1, "<path>", "Location of the merged winmd file" },
+        { "include", 0, cmd::option::no_max, "<prefix>", "One or more prefixes to include in output" },
+        { "exclude", 0, cmd::option::no_max, "<prefix>", "One or more prefixes to exclude from output" },
+        { "scan-depth", 0, 1, "<n>", "Depth of subfolders to scan in input folders (defaults to unlimited)" },
+        { "scan-match", 0, cmd::option::no_max, "<glob>", "One or more file name patterns to scan for in input folders" },
+        { "scan-skip", 0, cmd::option::no_max, "<glob>", "One or more file or folder name patterns to skip in input folders" },
+        { "verbose", 0, 0, {}, "Show detailed progress information" },
+        { "help", 0, cmd::option::no_max, {}, "Show detailed help with examples" },
+    };
+
+    static void print_usage(writer& w)
+    {
+        static auto printColumns = [](writer& w, std::string_view const& col1, std::string_view const& col2)
+        {
+            w.write_printf("  %-20s%s\n", col1.data(), col2.data());
+        };
+
+        static auto printOption = [](writer& w, cmd::option const& opt)
+        {
+            if (opt.desc.empty())
+            {
+                return;
+            }
+            printColumns(w, w.write_temp("-% %", opt.name, opt.arg), opt.desc);
+        };
+
+        auto format = R"(
+xlang_mdmerge v%
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+  xlang_mdmerge.exe [options...]
+
+Options:
+
+%  ^@<path>             Response file containing command line options
+
+Where <spec> is one or more of:
+
+  path                Path to winmd file or recursively scanned folder
+  local               Local ^%WinDir^%\System32\WinMetadata folder
+  sdk[+]              Current version of Windows SDK [with extensions]
+  10.0.12345.0[+]     Specific version of Windows SDK [with extensions]
+)";
+        w.write(format, XLANG_VERSION_STRING, bind_each(printOption, options));
+    }
+
+    static auto get_start_time()
+    {
+        return std::chrono::high_resolution_clock::now();
+    }
+
+    static auto get_elapsed_time(std::chrono::time_point<std::chrono::high_resolution_clock> const& start)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<int64_t, std::milli>>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    static int run(int const argc, char** argv)
+    {
+        int result{};
+        writer w;
+
+        try
+        {
+            auto start = get_start_time();
+            cmd::reader args{ argc, argv, options };
+
+            if (!args || args.exists("help"))
+            {
+                throw usage_exception{};
+            }
+
+            bool const verbose = args.exists("verbose");
+            auto const input = args.files("input", database::is_database, args.search());
+            std::filesystem::path const output = std::filesystem::absolute(args.value("output"));
+
+            if (input.empty())
+            {
+                throw_invalid("No metadata found for -input");
+            }
+
+            cache c{ input };
+            auto include = args.values("include");
+
+            // Excluding types on their own means merging everything else.
+            if (include.empty())
+            {
+                include.emplace_back();
+            }
+
+            filter f{ include, args.values("exclude") };
+            merger m{ c, f, output.filename().string() };
+
+            if (verbose)
+            {
+                w.write(" tool:  %\n", std::filesystem::canonical(argv[0]).string());
+                w.write(" ver:   %\n", XLANG_VERSION_STRING);
+
+                for (auto&& file : input)
+                {
+                    w.write(" in:    %\n", file);
+                }
+
+                w.write(" out:   %\n", output.string());
+                w.write(" types: %\n", m.type_count());
+            }
+
+            w.flush_to_console();
+
+            if (output.has_parent_path())
+            {
+                std::filesystem::create_directories(output.parent_path());
+            }
+
+            auto const image = m.save();
+            std::ofstream stream{ output, std::ios::binary };
+            stream.write(reinterpret_cast<char const*>(image.data()), image.size());
+
+            if (!stream)
+            {
+                throw_invalid("Could not write file '", output.string(), "'");
+            }
+
+            if (verbose)
+            {
+                w.write(" time:  %ms\n", get_elapsed_time(start));
+            }
+        }
+        catch (usage_exception const&)
+        {
+            print_usage(w);
+        }
+        catch (std::exception const& e)
+        {
+            w.write(" error: %\n", e.what());
+            result = 1;
+        }
+
+        w.flush_to_console();
+        return result;
+    }
+}
+
+int main(int const argc, char** argv)
+{
+    return xlang::run(argc, argv);
+}
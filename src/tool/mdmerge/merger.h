@@ -0,0 +1,858 @@
+#pragma once
+
+namespace xlang
+{
+    using namespace meta::reader;
+    using namespace meta::writer;
+
+    // Copies the Windows Runtime types selected by a filter from every database in a cache into a
+    // single database. References are rewritten as they are copied: a TypeRef whose target is one of
+    // the merged types becomes a reference to its TypeDef, and every other reference is shared
+    // between all the inputs that make it. Rows are emitted in namespace and type name order, so the
+    // metadata only depends on the inputs and the filter.
+    struct merger
+    {
+        merger(cache const& c, filter const& f, std::string_view const& name) : m_name(name)
+        {
+            select_types(c, f);
+
+            for (auto&& db : c.databases())
+            {
+                m_source_index.emplace(&db, m_sources.size());
+                m_sources.emplace_back(&db, db);
+            }
+
+            number_rows();
+        }
+
+        uint32_t type_count() const noexcept
+        {
+            return static_cast<uint32_t>(m_types.size());
+        }
+
+        std::vector<uint8_t> save()
+        {
+            m_writer.add_row(table_id::Module, { 0, m_writer.add_string(m_name), 0, 0, 0 });
+            m_writer.add_row(table_id::Assembly, { 0x8004, ~0ull, 0x200, 0, m_writer.add_string(std::filesystem::path{ m_name }.stem().string()), 0 }); // SHA1, 255.255.255.255, WindowsRuntime
+            m_writer.add_row(table_id::TypeDef, { 0, m_writer.add_string("<Module>"), 0, 0, 1, 1 });
+
+            for (auto&& type : m_types)
+            {
+                write_type(type);
+            }
+
+            write_method_semantics();
+            write_constants();
+            write_generic_params();
+            write_nested_classes();
+            write_custom_attributes();
+
+            m_writer.set_value(table_id::Module, 1, 2, m_writer.add_guid(make_mvid()));
+            return m_writer.save_to_memory();
+        }
+
+    private:
+
+        // Maps the rows of one input to their rows in the output, where zero means the row isn't copied.
+        struct source
+        {
+            explicit source(database const& db) :
+                type_def(db.TypeDef.size()),
+                field(db.Field.size()),
+                method_def(db.MethodDef.size()),
+                param(db.Param.size()),
+                interface_impl(db.InterfaceImpl.size()),
+                property(db.Property.size()),
+                event(db.Event.size()),
+                generic_param(db.GenericParam.size()),
+                member_ref(db.MemberRef.size()),
+                property_maps(db.TypeDef.size()),
+                event_maps(db.TypeDef.size())
+            {
+                for (auto&& map : db.PropertyMap)
+                {
+                    property_maps[map.Parent().index()] = map.index() + 1;
+                }
+
+                for (auto&& map : db.EventMap)
+                {
+                    event_maps[map.Parent().index()] = map.index() + 1;
+                }
+            }
+
+            std::vector<uint32_t> type_def;
+            std::vector<uint32_t> field;
+            std::vector<uint32_t> method_def;
+            std::vector<uint32_t> param;
+            std::vector<uint32_t> interface_impl;
+            std::vector<uint32_t> property;
+            std::vector<uint32_t> event;
+            std::vector<uint32_t> generic_param;
+            std::vector<uint32_t> member_ref;
+
+            // The PropertyMap and EventMap rows of each TypeDef, found once instead of per type.
+            std::vector<uint32_t> property_maps;
+            std::vector<uint32_t> event_maps;
+        };
+
+        // Filtering runs per namespace in parallel. The types are then numbered in namespace order
+        // so that references to them can be resolved before they are written.
+        void select_types(cache const& c, filter const& f)
+        {
+            std::vector<cache::namespace_members const*> namespaces;
+
+            for (auto&& [name, members] : c.namespaces())
+            {
+                namespaces.push_back(&members);
+            }
+
+            std::vector<std::vector<TypeDef>> selected(namespaces.size());
+            task_group group;
+
+            for (size_t index{}; index < namespaces.size(); ++index)
+            {
+                group.add([&, index]
+                {
+                    for (auto&& [name, type] : namespaces[index]->types)
+                    {
+                        if (f.includes(type))
+                        {
+                            selected[index].push_back(type);
+                        }
+                    }
+                });
+            }
+
+            group.get();
+
+            for (auto&& types : selected)
+            {
+                for (auto&& type : types)
+                {
+                    m_types.push_back(type);
+                    m_type_rows.try_emplace({ type.TypeNamespace(), type.TypeName() }, static_cast<uint32_t>(m_types.size() + 1));
+                }
+            }
+        }
+
+        // Types and their methods are written in m_types order after <Module>, so their rows are known
+        // before any is written. References to types and methods that come later can then be resolved.
+        void number_rows()
+        {
+            uint32_t method_row{};
+
+            for (size_t index{}; index < m_types.size(); ++index)
+            {
+                auto const& type = m_types[index];
+                auto& maps = get_source(type.get_database());
+                maps.type_def[type.index()] = static_cast<uint32_t>(index + 2);
+
+                for (auto&& method : type.MethodList())
+                {
+                    maps.method_def[method.index()] = ++method_row;
+                }
+            }
+        }
+
+        source& get_source(database const& db)
+        {
+            return m_sources[m_source_index.at(&db)].second;
+        }
+
+        void write_type(TypeDef const& type)
+        {
+            auto const& db = type.get_database();
+            auto& maps = get_source(db);
+            uint32_t const row = maps.type_def[type.index()];
+
+            m_writer.add_row(table_id::TypeDef,
+            {
+                type.get_value<uint32_t>(0),
+                m_writer.add_string(type.TypeName()),
+                m_writer.add_string(type.TypeNamespace()),
+                resolve_type(type.Extends()),
+                m_writer.row_count(table_id::Field) + 1,
+                m_writer.row_count(table_id::MethodDef) + 1
+            });
+
+            for (auto&& field : type.FieldList())
+            {
+                maps.field[field.index()] = m_writer.add_row(table_id::Field,
+                {
+                    field.get_value<uint16_t>(0),
+                    m_writer.add_string(field.Name()),
+                    add_signature(db, field.get_value<uint32_t>(2))
+                });
+            }
+
+            for (auto&& method : type.MethodList())
+            {
+                m_writer.add_row(table_id::MethodDef,
+                {
+                    0,
+                    method.get_value<uint16_t>(1),
+                    method.get_value<uint16_t>(2),
+                    m_writer.add_string(method.Name()),
+                    add_signature(db, method.get_value<uint32_t>(4)),
+                    m_writer.row_count(table_id::Param) + 1
+                });
+
+                for (auto&& param : method.ParamList())
+                {
+                    maps.param[param.index()] = m_writer.add_row(table_id::Param, { param.get_value<uint16_t>(0), param.Sequence(), m_writer.add_string(param.Name()) });
+                }
+            }
+
+            for (auto&& impl : type.InterfaceImpl())
+            {
+                maps.interface_impl[impl.index()] = m_writer.add_row(table_id::InterfaceImpl, { row, resolve_type(impl.Interface()) });
+            }
+
+            if (uint32_t const map = maps.property_maps[type.index()])
+            {
+                m_writer.add_row(table_id::PropertyMap, { row, m_writer.row_count(table_id::Property) + 1 });
+
+                for (auto&& property : db.PropertyMap[map - 1].PropertyList())
+                {
+                    maps.property[property.index()] = m_writer.add_row(table_id::Property,
+                    {
+                        property.get_value<uint16_t>(0),
+                        m_writer.add_string(property.Name()),
+                        add_signature(db, property.get_value<uint32_t>(2))
+                    });
+                }
+            }
+
+            if (uint32_t const map = maps.event_maps[type.index()])
+            {
+                m_writer.add_row(table_id::EventMap, { row, m_writer.row_count(table_id::Event) + 1 });
+
+                for (auto&& event : db.EventMap[map - 1].EventList())
+                {
+                    maps.event[event.index()] = m_writer.add_row(table_id::Event,
+                    {
+                        event.get_value<uint16_t>(0),
+                        m_writer.add_string(event.Name()),
+                        resolve_type(event.EventType())
+                    });
+                }
+            }
+
+            for (auto&& impl : type.MethodImplList())
+            {
+                m_writer.add_row(table_id::MethodImpl, { row, resolve_method(impl.MethodBody()), resolve_method(impl.MethodDeclaration()) });
+            }
+        }
+
+        void write_method_semantics()
+        {
+            for (auto&& [db, maps] : m_sources)
+            {
+                for (auto&& semantics : db->MethodSemantics)
+                {
+                    uint32_t const method = maps.method_def[semantics.Method().index()];
+                    auto const association = semantics.Association();
+                    uint32_t const parent = association.type() == HasSemantics::Event ? maps.event[association.index()] : maps.property[association.index()];
+
+                    if (method && parent)
+                    {
+                        m_writer.add_row(table_id::MethodSemantics, { semantics.get_value<uint16_t>(0), method, make_coded_index(association.type(), parent) });
+                    }
+                }
+            }
+        }
+
+        void write_constants()
+        {
+            for (auto&& [db, maps] : m_sources)
+            {
+                for (auto&& constant : db->Constant)
+                {
+                    auto const parent = constant.Parent();
+                    uint32_t row{};
+
+                    switch (parent.type())
+                    {
+                    case HasConstant::Field: row = maps.field[parent.index()]; break;
+                    case HasConstant::Param: row = maps.param[parent.index()]; break;
+                    case HasConstant::Property: row = maps.property[parent.index()]; break;
+                    }
+
+                    if (row)
+                    {
+                        m_writer.add_row(table_id::Constant, { constant.get_value<uint16_t>(0), make_coded_index(parent.type(), row), copy_blob(*db, constant.get_value<uint32_t>(2)) });
+                    }
+                }
+            }
+        }
+
+        // GenericParam and GenericParamConstraint must be sorted by owner, and other tables refer to
+        // their rows, so they are sorted before they are written rather than by the writer.
+        void write_generic_params()
+        {
+            struct generic_param
+            {
+                uint32_t owner;
+                GenericParam param;
+            };
+
+            std::vector<generic_param> params;
+
+            for (auto&& [db, maps] : m_sources)
+            {
+                for (auto&& param : db->GenericParam)
+                {
+                    auto const owner = param.Owner();
+                    uint32_t const row = owner.type() == TypeOrMethodDef::TypeDef ? maps.type_def[owner.index()] : maps.method_def[owner.index()];
+
+                    if (row)
+                    {
+                        params.push_back({ make_coded_index(owner.type(), row), param });
+                    }
+                }
+            }
+
+            std::stable_sort(params.begin(), params.end(), [](auto&& left, auto&& right)
+            {
+                return std::pair{ left.owner, left.param.Number() } < std::pair{ right.owner, right.param.Number() };
+            });
+
+            for (auto&& [owner, param] : params)
+            {
+                get_source(param.get_database()).generic_param[param.index()] = m_writer.add_row(table_id::GenericParam,
+                {
+                    param.Number(),
+                    param.get_value<uint16_t>(1),
+                    owner,
+                    m_writer.add_string(param.Name())
+                });
+            }
+
+            std::vector<std::pair<uint32_t, uint32_t>> constraints;
+
+            for (auto&& [db, maps] : m_sources)
+            {
+                for (auto&& constraint : db->GenericParamConstraint)
+                {
+                    if (uint32_t const owner = maps.generic_param[constraint.get_value<uint32_t>(0) - 1])
+                    {
+                        constraints.emplace_back(owner, resolve_type(coded_index<TypeDefOrRef>{ &db->TypeDef, constraint.get_value<uint32_t>(1) }));
+                    }
+                }
+            }
+
+            std::stable_sort(constraints.begin(), constraints.end(), [](auto&& left, auto&& right)
+            {
+                return left.first < right.first;
+            });
+
+            for (auto&& [owner, constraint] : constraints)
+            {
+                m_writer.add_row(table_id::GenericParamConstraint, { owner, constraint });
+            }
+        }
+
+        void write_nested_classes()
+        {
+            for (auto&& [db, maps] : m_sources)
+            {
+                for (auto&& nested : db->NestedClass)
+                {
+                    uint32_t const nested_type = maps.type_def[nested.get_value<uint32_t>(0) - 1];
+                    uint32_t const enclosing_type = maps.type_def[nested.get_value<uint32_t>(1) - 1];
+
+                    if (nested_type && enclosing_type)
+                    {
+                        m_writer.add_row(table_id::NestedClass, { nested_type, enclosing_type });
+                    }
+                }
+            }
+        }
+
+        void write_custom_attributes()
+        {
+            for (auto&& [db, maps] : m_sources)
+            {
+                for (auto&& attribute : db->CustomAttribute)
+                {
+                    auto const parent = attribute.Parent();
+                    uint32_t row{};
+
+                    switch (parent.type())
+                    {
+                    case HasCustomAttribute::TypeDef: row = maps.type_def[parent.index()]; break;
+                    case HasCustomAttribute::Field: row = maps.field[parent.index()]; break;
+                    case HasCustomAttribute::MethodDef: row = maps.method_def[parent.index()]; break;
+                    case HasCustomAttribute::Param: row = maps.param[parent.index()]; break;
+                    case HasCustomAttribute::InterfaceImpl: row = maps.interface_impl[parent.index()]; break;
+                    case HasCustomAttribute::Property: row = maps.property[parent.index()]; break;
+                    case HasCustomAttribute::Event: row = maps.event[parent.index()]; break;
+                    case HasCustomAttribute::GenericParam: row = maps.generic_param[parent.index()]; break;
+                    default: break;
+                    }
+
+                    if (!row)
+                    {
+                        continue;
+                    }
+
+                    // An attribute whose type isn't merged, such as GuidAttribute when filtering a
+                    // union winmd, is constructed through a MemberRef to the input that defines it.
+                    auto const type = attribute.Type();
+                    uint32_t constructor{};
+
+                    if (type.type() == CustomAttributeType::MemberRef)
+                    {
+                        constructor = make_coded_index(CustomAttributeType::MemberRef, add_member_ref(type.MemberRef()));
+                    }
+                    else if (uint32_t const method = maps.method_def[type.index()])
+                    {
+                        constructor = make_coded_index(CustomAttributeType::MethodDef, method);
+                    }
+                    else
+                    {
+                        constructor = make_coded_index(CustomAttributeType::MemberRef, add_member_ref(type.MethodDef()));
+                    }
+
+                    m_writer.add_row(table_id::CustomAttribute, { make_coded_index(parent.type(), row), constructor, copy_blob(*db, attribute.get_value<uint32_t>(2)) });
+                }
+            }
+        }
+
+        uint32_t copy_blob(database const& db, uint32_t const index)
+        {
+            auto const blob = db.get_blob(index);
+            return m_writer.add_blob(blob.begin(), blob.end());
+        }
+
+        // Returns the output's TypeDefOrRef coded index for a type referenced by an input.
+        uint32_t resolve_type(coded_index<TypeDefOrRef> const& type)
+        {
+            if (!type)
+            {
+                return 0;
+            }
+
+            auto const& db = type.get_database();
+
+            switch (type.type())
+            {
+            case TypeDefOrRef::TypeDef:
+            {
+                auto const definition = type.TypeDef();
+                return resolve_type_name(definition.TypeNamespace(), definition.TypeName(), [&] { return add_assembly_ref(db); });
+            }
+            case TypeDefOrRef::TypeRef:
+            {
+                auto const reference = type.TypeRef();
+                auto const scope = reference.ResolutionScope();
+
+                // A nested type is resolved through the type that encloses it.
+                if (scope.type() == ResolutionScope::TypeRef)
+                {
+                    uint32_t const enclosing = resolve_type(coded_index<TypeDefOrRef>{ &db.TypeDef, TypeDefOrRef::TypeRef, scope.index() });
+
+                    if (static_cast<TypeDefOrRef>(enclosing & 0x3) == TypeDefOrRef::TypeDef)
+                    {
+                        return resolve_nested_type(enclosing >> 2, reference.TypeNamespace(), reference.TypeName());
+                    }
+
+                    return add_type_ref(make_coded_index(ResolutionScope::TypeRef, enclosing >> 2), reference.TypeNamespace(), reference.TypeName());
+                }
+
+                return resolve_type_name(reference.TypeNamespace(), reference.TypeName(), [&]
+                {
+                    return scope.type() == ResolutionScope::AssemblyRef ? add_assembly_ref(db.AssemblyRef[scope.index()]) : add_assembly_ref(db);
+                });
+            }
+            default:
+            {
+                auto const signature = add_type_spec_signature(db, type.TypeSpec().get_value<uint32_t>(0));
+                auto [existing, inserted] = m_type_specs.try_emplace(signature, 0);
+
+                if (inserted)
+                {
+                    existing->second = m_writer.add_row(table_id::TypeSpec, { signature });
+                }
+
+                return make_coded_index(TypeDefOrRef::TypeSpec, existing->second);
+            }
+            }
+        }
+
+        template <typename Scope>
+        uint32_t resolve_type_name(std::string_view const& type_namespace, std::string_view const& type_name, Scope&& scope)
+        {
+            auto definition = m_type_rows.find({ type_namespace, type_name });
+
+            if (definition != m_type_rows.end())
+            {
+                return make_coded_index(TypeDefOrRef::TypeDef, definition->second);
+            }
+
+            return add_type_ref(make_coded_index(ResolutionScope::AssemblyRef, scope()), type_namespace, type_name);
+        }
+
+        // A type nested in a merged type resolves to the nested definition if that is merged too.
+        // Otherwise it is referred to through the input that defines the enclosing type.
+        uint32_t resolve_nested_type(uint32_t const enclosing_row, std::string_view const& type_namespace, std::string_view const& type_name)
+        {
+            auto const& enclosing = m_types[enclosing_row - 2];
+            auto const& db = enclosing.get_database();
+
+            for (auto&& nested : db.NestedClass)
+            {
+                if (nested.get_value<uint32_t>(1) - 1 != enclosing.index())
+                {
+                    continue;
+                }
+
+                auto const type = db.TypeDef[nested.get_value<uint32_t>(0) - 1];
+
+                if (type.TypeNamespace() == type_namespace && type.TypeName() == type_name)
+                {
+                    if (uint32_t const row = get_source(db).type_def[type.index()])
+                    {
+                        return make_coded_index(TypeDefOrRef::TypeDef, row);
+                    }
+
+                    break;
+                }
+            }
+
+            uint32_t const scope = add_type_ref(make_coded_index(ResolutionScope::AssemblyRef, add_assembly_ref(db)), enclosing.TypeNamespace(), enclosing.TypeName());
+            return add_type_ref(make_coded_index(ResolutionScope::TypeRef, scope >> 2), type_namespace, type_name);
+        }
+
+        uint32_t add_type_ref(uint32_t const scope, std::string_view const& type_namespace, std::string_view const& type_name)
+        {
+            auto [existing, inserted] = m_type_refs.try_emplace({ scope, std::string{ type_namespace }, std::string{ type_name } }, 0);
+
+            if (inserted)
+            {
+                existing->second = m_writer.add_row(table_id::TypeRef, { scope, m_writer.add_string(type_name), m_writer.add_string(type_namespace) });
+            }
+
+            return make_coded_index(TypeDefOrRef::TypeRef, existing->second);
+        }
+
+        uint32_t add_assembly_ref(uint64_t const version, uint32_t const flags, uint32_t const public_key, std::string_view const& name, std::string_view const& culture, uint32_t const hash)
+        {
+            auto [existing, inserted] = m_assembly_refs.try_emplace({ std::string{ name }, version }, 0);
+
+            if (inserted)
+            {
+                existing->second = m_writer.add_row(table_id::AssemblyRef, { version, flags, public_key, m_writer.add_string(name), m_writer.add_string(culture), hash });
+            }
+
+            return existing->second;
+        }
+
+        uint32_t add_assembly_ref(AssemblyRef const& reference)
+        {
+            auto const& db = reference.get_database();
+
+            return add_assembly_ref(
+                reference.get_value<uint64_t>(0),
+                reference.get_value<uint32_t>(1),
+                copy_blob(db, reference.get_value<uint32_t>(2)),
+                reference.Name(),
+                reference.Culture(),
+                copy_blob(db, reference.get_value<uint32_t>(5)));
+        }
+
+        // A reference to a type defined by an input but left out of the output points back to the input.
+        uint32_t add_assembly_ref(database const& db)
+        {
+            if (db.Assembly.size())
+            {
+                auto const assembly = db.Assembly[0];
+                return add_assembly_ref(assembly.get_value<uint64_t>(1), assembly.get_value<uint32_t>(2) & ~0x1u, 0, assembly.Name(), assembly.Culture(), 0);
+            }
+
+            return add_assembly_ref(~0ull, 0x200, 0, std::filesystem::path{ db.path() }.stem().string(), {}, 0);
+        }
+
+        uint32_t add_member_ref(MemberRef const& reference)
+        {
+            auto const& db = reference.get_database();
+            auto& row = get_source(db).member_ref[reference.index()];
+
+            if (row)
+            {
+                return row;
+            }
+
+            auto const parent = reference.Class();
+
+            if (parent.type() != MemberRefParent::TypeRef && parent.type() != MemberRefParent::TypeDef && parent.type() != MemberRefParent::TypeSpec)
+            {
+                throw_invalid("MemberRef '", reference.Name(), "' has an unsupported parent");
+            }
+
+            // The TypeDefOrRef tags of these tables are also their MemberRefParent tags, except for TypeSpec.
+            uint32_t const type = resolve_type(coded_index<TypeDefOrRef>{ &db.TypeDef, parent.type() == MemberRefParent::TypeSpec ? TypeDefOrRef::TypeSpec : static_cast<TypeDefOrRef>(parent.type()), parent.index() });
+            row = add_member_ref(type, reference.Name(), add_signature(db, reference.get_value<uint32_t>(2)));
+            return row;
+        }
+
+        // A method of a type that isn't merged is referred to through a MemberRef on a reference to its type.
+        uint32_t add_member_ref(MethodDef const& method)
+        {
+            auto const& db = method.get_database();
+            uint32_t const type = resolve_type(coded_index<TypeDefOrRef>{ &db.TypeDef, TypeDefOrRef::TypeDef, method.Parent().index() });
+            return add_member_ref(type, method.Name(), add_signature(db, method.get_value<uint32_t>(4)));
+        }
+
+        uint32_t add_member_ref(uint32_t const type, std::string_view const& name, uint32_t const signature)
+        {
+            auto const tag = static_cast<TypeDefOrRef>(type & 0x3);
+            uint32_t const owner = make_coded_index(tag == TypeDefOrRef::TypeSpec ? MemberRefParent::TypeSpec : static_cast<MemberRefParent>(tag), type >> 2);
+            auto [existing, inserted] = m_member_refs.try_emplace({ owner, std::string{ name }, signature }, 0);
+
+            if (inserted)
+            {
+                existing->second = m_writer.add_row(table_id::MemberRef, { owner, m_writer.add_string(name), signature });
+            }
+
+            return existing->second;
+        }
+
+        uint32_t resolve_method(coded_index<MethodDefOrRef> const& method)
+        {
+            if (method.type() == MethodDefOrRef::MethodDef)
+            {
+                if (uint32_t const row = get_source(method.get_database()).method_def[method.index()])
+                {
+                    return make_coded_index(MethodDefOrRef::MethodDef, row);
+                }
+
+                // An interface method whose interface the filter left out.
+                return make_coded_index(MethodDefOrRef::MemberRef, add_member_ref(method.MethodDef()));
+            }
+
+            return make_coded_index(MethodDefOrRef::MemberRef, add_member_ref(method.MemberRef()));
+        }
+
+        // Signatures are copied byte for byte except for the type tokens they contain, which refer
+        // to rows of the input and are replaced by the corresponding rows of the output.
+        static void copy_compressed(blob_cursor& cursor, std::vector<uint8_t>& output)
+        {
+            auto const bytes = cursor.read_bytes(cursor.compressed_size());
+            output.insert(output.end(), bytes.begin(), bytes.end());
+        }
+
+        static void write_compressed(std::vector<uint8_t>& output, uint32_t const value)
+        {
+            if (value < 0x80)
+            {
+                output.push_back(static_cast<uint8_t>(value));
+            }
+            else if (value < 0x4000)
+            {
+                output.push_back(static_cast<uint8_t>(0x80 | (value >> 8)));
+                output.push_back(static_cast<uint8_t>(value));
+            }
+            else
+            {
+                output.push_back(static_cast<uint8_t>(0xc0 | (value >> 24)));
+                output.push_back(static_cast<uint8_t>(value >> 16));
+                output.push_back(static_cast<uint8_t>(value >> 8));
+                output.push_back(static_cast<uint8_t>(value));
+            }
+        }
+
+        void rewrite_token(database const& db, blob_cursor& cursor, std::vector<uint8_t>& output)
+        {
+            write_compressed(output, resolve_type(coded_index<TypeDefOrRef>{ &db.TypeDef, cursor.read_compressed() }));
+        }
+
+        void rewrite_type(database const& db, blob_cursor& cursor, std::vector<uint8_t>& output)
+        {
+            while (true)
+            {
+                cursor.check();
+                auto const element = static_cast<ElementType>(cursor.read_byte());
+                output.push_back(static_cast<uint8_t>(element));
+
+                switch (element)
+                {
+                case ElementType::CModReqd:
+                case ElementType::CModOpt:
+                    rewrite_token(db, cursor, output);
+                    continue;
+                case ElementType::ByRef:
+                case ElementType::Ptr:
+                case ElementType::SZArray:
+                case ElementType::Pinned:
+                case ElementType::Sentinel:
+                    continue;
+                case ElementType::Class:
+                case ElementType::ValueType:
+                    rewrite_token(db, cursor, output);
+                    return;
+                case ElementType::GenericInst:
+                {
+                    output.push_back(cursor.read_byte());
+                    rewrite_token(db, cursor, output);
+                    uint32_t const count = cursor.read_compressed();
+                    write_compressed(output, count);
+
+                    for (uint32_t i{}; i < count; ++i)
+                    {
+                        rewrite_type(db, cursor, output);
+                    }
+
+                    return;
+                }
+                case ElementType::Var:
+                case ElementType::MVar:
+                    copy_compressed(cursor, output);
+                    return;
+                case ElementType::Array:
+                {
+                    rewrite_type(db, cursor, output);
+                    copy_compressed(cursor, output);
+
+                    for (uint32_t bounds{}; bounds < 2; ++bounds)
+                    {
+                        uint32_t const count = cursor.read_compressed();
+                        write_compressed(output, count);
+
+                        for (uint32_t i{}; i < count; ++i)
+                        {
+                            copy_compressed(cursor, output);
+                        }
+                    }
+
+                    return;
+                }
+                case ElementType::FnPtr:
+                    rewrite_method(db, cursor, output);
+                    return;
+                default:
+                    return;
+                }
+            }
+        }
+
+        void rewrite_method(database const& db, blob_cursor& cursor, std::vector<uint8_t>& output)
+        {
+            uint8_t const convention = cursor.read_byte();
+            output.push_back(convention);
+
+            if (convention & 0x10) // Generic
+            {
+                copy_compressed(cursor, output);
+            }
+
+            uint32_t const count = cursor.read_compressed();
+            write_compressed(output, count);
+
+            for (uint32_t i{}; i <= count; ++i)
+            {
+                rewrite_type(db, cursor, output);
+            }
+        }
+
+        std::vector<uint8_t> rewrite_signature(database const& db, uint32_t const index)
+        {
+            blob_cursor cursor{ db.get_blob(index) };
+            std::vector<uint8_t> output;
+
+            if (cursor.empty())
+            {
+                return output;
+            }
+
+            switch (cursor.peek() & 0x0f)
+            {
+            case 0x06: // Field
+                output.push_back(cursor.read_byte());
+                rewrite_type(db, cursor, output);
+                break;
+            case 0x07: // LocalSig
+            case 0x0a: // GenericInst
+            {
+                output.push_back(cursor.read_byte());
+                uint32_t const count = cursor.read_compressed();
+                write_compressed(output, count);
+
+                for (uint32_t i{}; i < count; ++i)
+                {
+                    rewrite_type(db, cursor, output);
+                }
+
+                break;
+            }
+            default: // Method or property
+                rewrite_method(db, cursor, output);
+                break;
+            }
+
+            cursor.check();
+            output.insert(output.end(), cursor.begin(), cursor.end());
+            return output;
+        }
+
+        uint32_t add_signature(database const& db, uint32_t const index)
+        {
+            return m_writer.add_blob(rewrite_signature(db, index));
+        }
+
+        uint32_t add_type_spec_signature(database const& db, uint32_t const index)
+        {
+            blob_cursor cursor{ db.get_blob(index) };
+            std::vector<uint8_t> output;
+            rewrite_type(db, cursor, output);
+            cursor.check();
+            return m_writer.add_blob(output);
+        }
+
+        // Derives the module's identity from its name and contents so that merging the same inputs
+        // twice produces the same file.
+        std::array<uint8_t, 16> make_mvid() const
+        {
+            uint64_t first = 0xcbf29ce484222325;
+            uint64_t second = 0x84222325cbf29ce4;
+
+            auto hash = [&](std::string_view const& value)
+            {
+                for (char const c : value)
+                {
+                    first = (first ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+                    second = (second ^ static_cast<uint8_t>(c)) * 0x100000001b3 + 1;
+                }
+            };
+
+            hash(m_name);
+
+            for (auto&& type : m_types)
+            {
+                hash(type.TypeNamespace());
+                hash(type.TypeName());
+            }
+
+            std::array<uint8_t, 16> result{};
+
+            for (uint32_t i{}; i < 8; ++i)
+            {
+                result[i] = static_cast<uint8_t>(first >> (i * 8));
+                result[i + 8] = static_cast<uint8_t>(second >> (i * 8));
+            }
+
+            return result;
+        }
+
+        std::string m_name;
+        database_writer m_writer;
+        std::vector<TypeDef> m_types;
+        std::map<std::pair<std::string_view, std::string_view>, uint32_t> m_type_rows;
+        std::vector<std::pair<database const*, source>> m_sources;
+        std::map<database const*, size_t> m_source_index;
+        std::map<std::tuple<uint32_t, std::string, std::string>, uint32_t> m_type_refs;
+        std::map<std::pair<std::string, uint64_t>, uint32_t> m_assembly_refs;
+        std::map<std::tuple<uint32_t, std::string, uint32_t>, uint32_t> m_member_refs;
+        std::map<uint32_t, uint32_t> m_type_specs;
+    };
+}
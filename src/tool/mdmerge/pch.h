@@ -0,0 +1,7 @@
+#pragma once
+
+#include "cmd_reader.h"
+#include "meta_reader.h"
+#include "meta_writer.h"
+#include "task_group.h"
+#include "text_writer.h"
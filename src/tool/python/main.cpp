@@ -21,6 +21,9 @@ namespace pywinrt
         { "output", 0, 1, "<path>", "Location of generated projection" },
         { "include", 0, cmd::option::no_max, "<prefix>", "One or more prefixes to include in projection" },
         { "exclude", 0, cmd::option::no_max, "<prefix>", "One or more prefixes to exclude from projection" },
+        { "scan-depth", 0, 1, "<n>", "Depth of subfolders to scan in input folders (defaults to unlimited)" },
+        { "scan-match", 0, cmd::option::no_max, "<glob>", "One or more file name patterns to scan for in input folders" },
+        { "scan-skip", 0, cmd::option::no_max, "<glob>", "One or more file or folder name patterns to skip in input folders" },
         { "verbose", 0, 0, {}, "Show detailed progress information" },
         { "module", 0, 1, "<name>", "Name of generated projection. Defaults to winrt."},
         { "help", 0, cmd::option::no_max, {}, "Show detailed help" },
@@ -73,7 +76,7 @@ Where <spec> is one or more of:
 
         settings.verbose = args.exists("verbose");
         settings.module = args.value("module", "winrt");
-        settings.input = args.files("input", database::is_database);
+        settings.input = args.files("input", database::is_database, args.search());
 
         for (auto && include : args.values("include"))
         {
@@ -115,7 +118,8 @@ Where <spec> is one or more of:
         {
             auto start = get_start_time();
             process_args(argc, argv);
-            cache c{ get_files_to_cache() };
+            auto shared = shared_cache::get(get_files_to_cache());
+            cache const& c = shared->get();
             settings.filter = { settings.include, settings.exclude };
 
             if (settings.verbose)
@@ -149,7 +153,7 @@ Where <spec> is one or more of:
 
             for (auto&&[ns, members] : c.namespaces())
             {
-                if (!has_projected_types(members) || !settings.filter.includes(members))
+                if (!settings.filter.includes(members) || !has_projected_types(members))
                 {
                     continue;
                 }
@@ -166,7 +170,7 @@ Where <spec> is one or more of:
                 
                 create_directories(ns_dir);
 
-                group.add([&src_dir, ns_dir, ns = ns, members = members]
+                group.add([&src_dir, ns_dir, ns = ns, &members = members]
                 {
                     auto namespaces = write_namespace_cpp(src_dir, ns, members);
                     write_namespace_h(src_dir, ns, namespaces, members);
@@ -180,6 +184,7 @@ Where <spec> is one or more of:
 
             if (settings.verbose)
             {
+                c.memory_report().write(w);
                 w.write("time: %ms\n", get_elapsed_time(start));
             }
         }